@@ -0,0 +1,124 @@
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "AssetArchive.h"
+#include "../log/log.h"
+
+AssetArchive::~AssetArchive() {
+    close();
+}
+
+/**
+ * Maps the whole file read only and indexes its entries by name. Pages are only read from
+ * disk when an asset is first touched. Any entry reaching outside the file fails the open.
+ */
+bool AssetArchive::open(const std::string& path) {
+    close();
+
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(ArchiveHeader)) {
+        ::close(fd);
+        return false;
+    }
+
+    void *mapping = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        logv("Cannot map %s\n", path.c_str());
+        return false;
+    }
+    base = static_cast<uint8_t *>(mapping);
+    length = info.st_size;
+
+    const ArchiveHeader *header = reinterpret_cast<const ArchiveHeader *>(base);
+    if (memcmp(header->magic, ARCHIVE_MAGIC, sizeof(ARCHIVE_MAGIC)) != 0 || header->version != ARCHIVE_VERSION
+            || sizeof(ArchiveHeader) + header->entries * sizeof(ArchiveEntry) > length) {
+        logv("%s is not a version %u asset archive\n", path.c_str(), ARCHIVE_VERSION);
+        close();
+        return false;
+    }
+
+    const ArchiveEntry *entries = reinterpret_cast<const ArchiveEntry *>(base + sizeof(ArchiveHeader));
+    for (uint32_t i = 0; i < header->entries; ++i) {
+        const ArchiveEntry& e = entries[i];
+        if (e.nameOffset + e.nameLength > length || e.offset + e.size > length) {
+            logv("%s is truncated\n", path.c_str());
+            close();
+            return false;
+        }
+        index[std::string(reinterpret_cast<const char *>(base + e.nameOffset), e.nameLength)] = &e;
+    }
+
+    logv("Mapped %zu assets from %s\n", index.size(), path.c_str());
+    return true;
+}
+
+void AssetArchive::close() {
+    if (base != nullptr) {
+        munmap(base, length);
+    }
+    base = nullptr;
+    length = 0;
+    index.clear();
+}
+
+const ArchiveEntry *AssetArchive::find(const std::string& name) const {
+    const auto entry = index.find(name);
+    return entry != index.end() ? entry->second : nullptr;
+}
+
+/**
+ * Compares the loose file's size and modification time with the ones recorded when it was packed.
+ * A release may ship the archive without the loose files, so an entry whose file is missing is
+ * still used. A stat per asset is nothing next to decoding it.
+ */
+bool AssetArchive::isCurrent(const std::string& name, const ArchiveEntry& entry) {
+    struct stat info;
+    if (stat(name.c_str(), &info) != 0) {
+        return true;
+    }
+    if (static_cast<uint64_t>(info.st_size) != entry.sourceSize
+            || static_cast<int64_t>(info.st_mtime) != entry.sourceModified) {
+        logv("%s changed since it was packed, loading the loose file\n", name.c_str());
+        return false;
+    }
+    return true;
+}
+
+SDL_Surface *AssetArchive::surface(const std::string& name) const {
+    const ArchiveEntry *e = find(name);
+    if (e == nullptr || e->kind != ArchiveKind::PIXELS || e->size < uint64_t(e->width) * e->height * 4
+            || !isCurrent(name, *e)) {
+        return nullptr;
+    }
+
+    // SDL only reads the pixels of a surface it is blitting from or uploading
+    return SDL_CreateRGBSurfaceWithFormatFrom(base + e->offset, e->width, e->height, 32, e->width * 4,
+        SDL_PIXELFORMAT_ARGB8888);
+}
+
+Mix_Chunk *AssetArchive::chunk(const std::string& name) const {
+    const ArchiveEntry *e = find(name);
+    if (e == nullptr || e->kind != ArchiveKind::PCM || !isCurrent(name, *e)) {
+        return nullptr;
+    }
+
+    int frequency;
+    Uint16 format;
+    int channels;
+    if (Mix_QuerySpec(&frequency, &format, &channels) == 0 || static_cast<uint32_t>(frequency) != e->frequency
+            || format != e->format || static_cast<uint32_t>(channels) != e->channels) {
+        return nullptr;
+    }
+
+    // the mixer does not own or write quick loaded samples
+    return Mix_QuickLoad_RAW(base + e->offset, e->size);
+}
@@ -0,0 +1,81 @@
+#ifndef ASSETARCHIVE_H
+#define ASSETARCHIVE_H
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_mixer.h>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+// built by the packer target from the loose files under assets/
+const std::string ASSET_ARCHIVE = "assets/assets.pak";
+
+static constexpr char ARCHIVE_MAGIC[8] = {'M', 'A', 'R', 'Z', 'P', 'A', 'K', '\0'};
+static constexpr uint32_t ARCHIVE_VERSION = 2;
+static constexpr uint64_t ARCHIVE_ALIGN = 16; // every blob starts on this boundary
+
+enum class ArchiveKind : uint32_t {
+    PIXELS, // ARGB8888 rows of width * 4 bytes, colour key already turned into alpha
+    PCM // samples in the mixer format recorded with them
+};
+
+/*
+ * Layout of an archive, in host byte order:
+ *   ArchiveHeader, ArchiveEntry[entries], entry names, then the blobs each aligned to ARCHIVE_ALIGN.
+ * Entries are named by the path the loose file had, eg. "assets/sounds/Drop 1.ogg", and record
+ * that file's size and modification time so an entry packed before the file changed is skipped.
+ */
+struct ArchiveHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t entries;
+};
+
+struct ArchiveEntry {
+    uint32_t nameOffset; // from the start of the archive
+    uint32_t nameLength;
+    ArchiveKind kind;
+    uint32_t width; // PIXELS
+    uint32_t height;
+    uint32_t frequency; // PCM, the Mix_QuerySpec the samples were converted for
+    uint32_t format;
+    uint32_t channels;
+    uint64_t offset; // from the start of the archive
+    uint64_t size;
+    uint64_t sourceSize; // of the loose file when it was packed
+    int64_t sourceModified; // its st_mtime, in seconds
+};
+
+/*
+ * Read only view of a packed asset archive mapped into memory.
+ * Assets are handed out as views into the mapping rather than copies, so the archive
+ * must stay open for as long as anything made from it is alive.
+ */
+class AssetArchive {
+public:
+    AssetArchive() = default;
+    ~AssetArchive();
+
+    AssetArchive(const AssetArchive&) = delete;
+    AssetArchive& operator=(const AssetArchive&) = delete;
+
+    bool open(const std::string& path); // maps the archive and reads its index, returns success
+    void close();
+    bool isOpen() const {return base != nullptr;}
+
+    const ArchiveEntry *find(const std::string& name) const; // nullptr when the archive has no such entry
+    // whether the loose file is gone or still the one the entry was packed from
+    static bool isCurrent(const std::string& name, const ArchiveEntry& entry);
+
+    // surface over the entry's pixels without copying them, nullptr if it is missing, stale or not PIXELS
+    SDL_Surface *surface(const std::string& name) const;
+    // chunk playing straight from the mapping, nullptr if it is missing, stale, not PCM or for another mixer format
+    Mix_Chunk *chunk(const std::string& name) const;
+
+private:
+    uint8_t *base = nullptr;
+    size_t length = 0;
+    std::unordered_map<std::string, const ArchiveEntry *> index;
+};
+
+#endif
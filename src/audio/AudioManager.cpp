@@ -22,16 +22,14 @@ AudioManager& AudioManager::instance() {
     return sInstance;
 }
 
+//The mixer is opened by Game::init, not here: the instance is static and would open audio
+//before main in every binary linking it, the headless server included.
 AudioManager::AudioManager(){
- 
-    Mix_OpenAudio( 44100, MIX_DEFAULT_FORMAT, 2, 2048 );
 
-    loadFiles();
 }
 
 
 AudioManager::~AudioManager(){
-    Mix_CloseAudio();
     //clear all loaded files
     for(auto const& music : _music) {
         Mix_FreeMusic(music.second);
@@ -75,33 +73,22 @@ void AudioManager::playEffect(const char * fileName){
 
 
 void AudioManager::loadFiles(){
-    
-    ////MUSIC
-    loadMusic(MUS_DARKNUBULA);
-    loadMusic(MUS_TESTMENU01);
-
-
-    ////CHUNKS
-    //marine
-    loadEffect(EFX_PDROP01);
-    loadEffect(EFX_PDROP02);
-    loadEffect(EFX_PPICK01);
-    loadEffect(EFX_PPICK02);
-
-    loadEffect(EFX_PGRUNT01);
-    loadEffect(EFX_PDEATH01);
+    for (const char * fileName : MUSIC_FILES) {
+        loadMusic(fileName);
+    }
+    for (const char * fileName : EFFECT_FILES) {
+        loadEffect(fileName);
+    }
+}
 
-    //weapon
-    loadEffect(EFX_WLPISTOL);
-    loadEffect(EFX_WLRIFLE);
 
-    loadEffect(EFX_WRELOAD01);
-    loadEffect(EFX_WTURRET01);
+void AudioManager::addMusic(const char * fileName, Mix_Music * music){
+    _music[fileName] = music;
+}
 
-    //zombie
-    loadEffect(EFX_ZGROAN01);
-    loadEffect(EFX_ZGRUNT01);
 
+void AudioManager::addEffect(const char * fileName, Mix_Chunk * chunk){
+    _chunks[fileName] = chunk;
 }
 
 
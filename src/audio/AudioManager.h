@@ -11,10 +11,16 @@
 #include <iomanip>
 #include <cstring>
 #include <map>
+#include <vector>
 
 
 #define AUDIO_PATH "assets/sounds/"
 
+//mixer format the game opens, effects in the asset archive are stored already converted to it
+static constexpr int AUDIO_FREQUENCY = 44100;
+static constexpr int AUDIO_CHANNELS = 2;
+static constexpr int AUDIO_CHUNK_SIZE = 2048;
+
 //music
 #define MUS_DARKNUBULA  AUDIO_PATH "Dark Nebula.ogg"
 #define MUS_TESTMENU01  AUDIO_PATH "~testsound_menuv01.ogg"
@@ -40,6 +46,17 @@
 #define EFX_ZGRUNT01    AUDIO_PATH "~testsound_zombiegrunt1.ogg"
 
 
+//every file the manager plays, decoded by the AssetLoader at startup
+const std::vector<const char *> MUSIC_FILES = {MUS_DARKNUBULA, MUS_TESTMENU01};
+const std::vector<const char *> EFFECT_FILES = {
+    //marine
+    EFX_PDROP01, EFX_PDROP02, EFX_PPICK01, EFX_PPICK02, EFX_PGRUNT01, EFX_PDEATH01,
+    //weapon
+    EFX_WLPISTOL, EFX_WLRIFLE, EFX_WRELOAD01, EFX_WTURRET01,
+    //zombie
+    EFX_ZGROAN01, EFX_ZGRUNT01,
+};
+
 //maps for storing loaded files.
 typedef std::map<std::string, Mix_Music*> musicMap;
 typedef std::map<std::string, Mix_Chunk*> chunkMap;
@@ -53,6 +70,12 @@ public:
     void playMusic(const char * fileName);
     void playEffect(const char * fileName);
 
+    //stores files decoded elsewhere, the manager frees them
+    void addMusic(const char * fileName, Mix_Music * music);
+    void addEffect(const char * fileName, Mix_Chunk * chunk);
+
+    void loadFiles(); //loads every file on the calling thread
+
 private:
     static AudioManager sInstance;
 
@@ -62,7 +85,6 @@ private:
     AudioManager();
     ~AudioManager();
 
-    void loadFiles();
     void loadMusic(const char * fileName);
     void loadEffect(const char * fileName);
 };
@@ -39,7 +39,7 @@ Entity::Entity(int32_t nid,  const SDL_Rect dest, const SDL_Rect &movementSize,
 
 Entity::Entity(const Entity &e): id(e.id), destRect(e.destRect), srcRect(e.srcRect),
         movementHitBox(e.movementHitBox), projectileHitBox(e.projectileHitBox),
-        damageHitBox(e.damageHitBox), pickupHitBox(e.pickupHitBox), x(e.x), y(e.y) {
+        damageHitBox(e.damageHitBox), pickupHitBox(e.pickupHitBox), x(e.x), y(e.y), animation(e.animation) {
 }
 
 const SDL_Rect Entity::getRelativeDestRect(const SDL_Rect& view) const {
@@ -83,6 +83,8 @@ int Entity::getH() const{
 void Entity::setPosition(float px, float py) {
     x = px;
     y = py;
+    destRect.x = px;
+    destRect.y = py;
     updateHitBoxes();
 }
 
@@ -6,6 +6,7 @@
 #include <SDL2/SDL.h>
 
 #include "../collision/HitBox.h"
+#include "../sprites/Animation.h"
 
 
 class Entity {
@@ -55,6 +56,9 @@ public:
     void setDestRect(int x, int y, int width, int height);
     void setSrcRect(int x, int y, int width, int height);
 
+    uint16_t getAnimation() const {return animation;} // NO_ANIMATION unless its sprite is a sheet
+    void setAnimation(const uint16_t a) {animation = a;}
+
     void moveMoveHitBox(int x, int y) { movementHitBox.move(x,y);};
     void moveProHitBox(int x, int y) { projectileHitBox.move(x,y);};
     void moveDamHitBox(int x, int y) { damageHitBox.move(x,y);};
@@ -71,6 +75,7 @@ private:
     HitBox pickupHitBox;
     float x;
     float y;
+    uint16_t animation = NO_ANIMATION; // clip played from its sprite sheet
 };
 
 #endif
@@ -0,0 +1,131 @@
+#include <algorithm>
+#include <chrono>
+#include <inttypes.h>
+
+#include "Bench.h"
+
+using BenchClock = std::chrono::steady_clock;
+
+Bench::Bench(FILE *out, const std::string& filter) : out(out), filter(filter), engine(BENCH_SEED) {
+}
+
+bool Bench::enabled(const std::string& name) const {
+    return filter.empty() || name.find(filter) != std::string::npos;
+}
+
+/**
+ * Times body at the given entity count.
+ * The number of iterations per sample is calibrated so each sample runs for at least
+ * BENCH_MIN_SAMPLE_NS, then BENCH_SAMPLES samples are taken and the median and minimum reported.
+ * When a teardown is given every iteration is timed on its own so the teardown stays untimed.
+ */
+void Bench::run(const std::string& name, const int entities, const std::function<void()>& setup,
+        const std::function<void()>& body, const std::function<void()>& teardown) {
+    if (!enabled(name)) {
+        return;
+    }
+
+    engine.seed(BENCH_SEED);
+    if (setup) {
+        setup();
+    }
+
+    // times count iterations of body, returns total ns
+    auto sample = [&](const long count) {
+        double total = 0;
+        if (teardown) {
+            for (long i = 0; i < count; ++i) {
+                const auto start = BenchClock::now();
+                body();
+                total += std::chrono::duration<double, std::nano>(BenchClock::now() - start).count();
+                teardown();
+            }
+        } else {
+            const auto start = BenchClock::now();
+            for (long i = 0; i < count; ++i) {
+                body();
+            }
+            total = std::chrono::duration<double, std::nano>(BenchClock::now() - start).count();
+        }
+        return total;
+    };
+
+    // calibrate, doubling the iteration count until a sample is long enough
+    long iterations = 1;
+    while (sample(iterations) < BENCH_MIN_SAMPLE_NS && iterations < (1L << 24)) {
+        iterations *= 2;
+    }
+
+    std::vector<double> samples;
+    for (int i = 0; i < BENCH_SAMPLES; ++i) {
+        samples.push_back(sample(iterations) / iterations);
+    }
+    std::sort(samples.begin(), samples.end());
+
+    const double median = samples[samples.size() / 2];
+    fprintf(out, "{\"bench\":\"%s\",\"entities\":%d,\"iterations\":%ld,\"median_ns\":%.1f,"
+            "\"min_ns\":%.1f,\"ns_per_entity\":%.3f}\n", name.c_str(), entities, iterations, median,
+            samples.front(), entities > 0 ? median / entities : median);
+    fflush(out);
+}
+
+void Bench::metric(const std::string& name, const int entities, const std::string& key, const double value) {
+    if (!enabled(name)) {
+        return;
+    }
+    fprintf(out, "{\"bench\":\"%s\",\"entities\":%d,\"%s\":%.3f}\n", name.c_str(), entities, key.c_str(), value);
+    fflush(out);
+}
+
+void Bench::expect(const std::string& name, const int entities, const std::string& key, const uint32_t value) {
+    if (!enabled(name)) {
+        return;
+    }
+    fprintf(out, "{\"bench\":\"%s\",\"entities\":%d,\"%s\":%" PRIu32 "}\n", name.c_str(), entities, key.c_str(),
+        value);
+    fflush(out);
+
+    const std::string id = name + " " + key;
+    seen[id] = value;
+    if (!checking) {
+        return;
+    }
+    const auto it = golden.find(id);
+    if (it == golden.end()) {
+        fprintf(stderr, "%s: no golden value, got %" PRIu32 "\n", id.c_str(), value);
+        ++failures;
+    } else if (it->second != value) {
+        fprintf(stderr, "%s: expected %" PRIu32 ", got %" PRIu32 "\n", id.c_str(), it->second, value);
+        ++failures;
+    }
+}
+
+bool Bench::loadGolden(const std::string& path) {
+    FILE *file = fopen(path.c_str(), "r");
+    if (file == nullptr) {
+        perror(path.c_str());
+        return false;
+    }
+    char name[128];
+    char key[64];
+    uint32_t value;
+    while (fscanf(file, "%127s %63s %" SCNu32, name, key, &value) == 3) {
+        golden[std::string(name) + " " + key] = value;
+    }
+    fclose(file);
+    checking = true;
+    return true;
+}
+
+bool Bench::saveGolden(const std::string& path) const {
+    FILE *file = fopen(path.c_str(), "w");
+    if (file == nullptr) {
+        perror(path.c_str());
+        return false;
+    }
+    for (const auto& v : seen) {
+        fprintf(file, "%s %" PRIu32 "\n", v.first.c_str(), v.second);
+    }
+    fclose(file);
+    return true;
+}
@@ -0,0 +1,86 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <stdio.h>
+#include <functional>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+// seed shared by every benchmark so entity layouts are identical between runs and commits
+constexpr unsigned int BENCH_SEED = 4981;
+
+// number of timed samples per measurement, the median is reported
+constexpr int BENCH_SAMPLES = 7;
+
+// a sample is repeated until it takes at least this long (ns)
+constexpr double BENCH_MIN_SAMPLE_NS = 20000000.0;
+
+// entity counts every scaling benchmark is run at
+const std::vector<int> BENCH_COUNTS = {100, 500, 1000, 2000, 5000};
+
+// viewport the render benchmarks draw, the default window size
+constexpr int BENCH_VIEW_W = 1280;
+constexpr int BENCH_VIEW_H = 720;
+
+/*
+ * Micro-benchmark harness used by the bench target.
+ * Every measurement is written as one JSON object per line so the output of two
+ * commits can be diffed directly or loaded by a script.
+ */
+class Bench {
+public:
+    Bench(FILE *out, const std::string& filter);
+    ~Bench() = default;
+
+    // true when the benchmark name matches the -f filter
+    bool enabled(const std::string& name) const;
+
+    // setup runs once before timing, body is timed and teardown runs untimed after every body call
+    void run(const std::string& name, const int entities, const std::function<void()>& setup,
+            const std::function<void()>& body, const std::function<void()>& teardown = nullptr);
+
+    // emits a free form metric that is not a timing, eg. bytes per entity
+    void metric(const std::string& name, const int entities, const std::string& key, const double value);
+
+    // emits a value that must not change between commits, eg. a frame hash, and checks it against
+    // the golden value loaded for it, a mismatch or a missing golden value is reported and counted
+    void expect(const std::string& name, const int entities, const std::string& key, const uint32_t value);
+
+    // golden values of expect, one "name key value" line each
+    bool loadGolden(const std::string& path);
+    bool saveGolden(const std::string& path) const; // the values expect saw this run
+    int getFailures() const {return failures;}
+
+    // deterministic generator, reseeded for every benchmark
+    std::mt19937& rng() {return engine;}
+
+private:
+    FILE *out;
+    std::string filter;
+    std::mt19937 engine;
+    bool checking = false; // golden values were loaded
+    std::map<std::string, uint32_t> golden; // by "name key"
+    std::map<std::string, uint32_t> seen;
+    int failures = 0;
+};
+
+// fills the GameManager with n zombies at deterministic positions across the map
+void spawnZombies(Bench& bench, const int n);
+
+// removes every zombie from the GameManager
+void clearZombies();
+
+// benchmark suites, one file each
+void collisionBenchmarks(Bench& bench);
+void zombieBenchmarks(Bench& bench);
+void turretBenchmarks(Bench& bench);
+void managerBenchmarks(Bench& bench);
+void projectileBenchmarks(Bench& bench);
+void renderBenchmarks(Bench& bench);
+void frameBenchmarks(Bench& bench);
+void snapshotBenchmarks(Bench& bench);
+void predictionBenchmarks(Bench& bench);
+
+#endif
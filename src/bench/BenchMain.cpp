@@ -0,0 +1,86 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <getopt.h>
+#include <string>
+
+#include "Bench.h"
+#include "../sprites/Renderer.h"
+#include "../log/log.h"
+
+/*
+ * Entry point of the bench target.
+ * Usage: bin/bench [-f filter] [-o file] [-g file] [-u file]
+ *   -f  only run benchmarks whose name contains filter
+ *   -o  write results to file instead of stdout
+ *   -g  check the frame hashes against the golden values in file, exits with 1 on a mismatch
+ *   -u  write the frame hashes of this run to file as the new golden values
+ * The golden values are checked in as src/bench/golden.txt, run from the repository root:
+ *   bin/bench -f frame -g src/bench/golden.txt
+ */
+int main(int argc, char *argv[]) {
+    std::string filter;
+    std::string goldenIn;
+    std::string goldenOut;
+    FILE *out = stdout;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "f:o:g:u:")) != -1) {
+        switch (opt) {
+            case 'f':
+                filter = optarg;
+                break;
+            case 'o':
+                if ((out = fopen(optarg, "w")) == nullptr) {
+                    perror("fopen");
+                    return 1;
+                }
+                break;
+            case 'g':
+                goldenIn = optarg;
+                break;
+            case 'u':
+                goldenOut = optarg;
+                break;
+            case '?':
+                printf("-f filter\n-o output file\n-g golden file to check\n-u golden file to write\n");
+                return 1;
+        }
+    }
+
+    // keep the entity constructors quiet while timing
+    log_verbose = 0;
+
+    // the render benchmarks draw offscreen with the software renderer, no display or GPU needed,
+    // the surface lives until exit like the renderer drawing into it
+    SDL_Surface *frame = SDL_CreateRGBSurfaceWithFormat(0, BENCH_VIEW_W, BENCH_VIEW_H, 32, SDL_PIXELFORMAT_ARGB8888);
+    if (frame == nullptr || !Renderer::setSurface(frame)) {
+        fprintf(stderr, "no offscreen renderer, render benchmarks draw nothing\n");
+    }
+
+    Bench bench(out, filter);
+    if (!goldenIn.empty() && !bench.loadGolden(goldenIn)) {
+        return 1;
+    }
+
+    collisionBenchmarks(bench);
+    managerBenchmarks(bench);
+    zombieBenchmarks(bench);
+    turretBenchmarks(bench);
+    projectileBenchmarks(bench);
+    renderBenchmarks(bench);
+    frameBenchmarks(bench);
+    snapshotBenchmarks(bench);
+    predictionBenchmarks(bench);
+
+    if (out != stdout) {
+        fclose(out);
+    }
+    if (!goldenOut.empty() && !bench.saveGolden(goldenOut)) {
+        return 1;
+    }
+    if (bench.getFailures() > 0) {
+        fprintf(stderr, "%d golden values differ\n", bench.getFailures());
+        return 1;
+    }
+    return 0;
+}
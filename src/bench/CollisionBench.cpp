@@ -0,0 +1,133 @@
+#include <cmath>
+#include <utility>
+#include <vector>
+
+#include "Bench.h"
+#include "../basic/Entity.h"
+#include "../collision/Quadtree.h"
+#include "../collision/CollisionHandler.h"
+#include "../game/GameManager.h"
+#include "../inventory/weapons/ShotGun.h"
+
+// builds n standalone entities scattered over the map
+static std::vector<Entity> makeEntities(Bench& bench, const int n) {
+    std::uniform_int_distribution<int> pos(0, MAP_WIDTH - defaultSize);
+    std::vector<Entity> entities;
+    entities.reserve(n);
+    for (int i = 0; i < n; ++i) {
+        entities.emplace_back(i, SDL_Rect{pos(bench.rng()), pos(bench.rng()), defaultSize, defaultSize});
+    }
+    return entities;
+}
+
+// rays cast per raycast iteration, about a second of constant rifle fire from a full squad
+constexpr int BENCH_RAYS = 100;
+
+/**
+ * Quadtree insert/retrieve, CollisionHandler::detectMovementCollision and CollisionHandler::raycast,
+ * for single rays and for shotgun blasts cast pellet by pellet or batched.
+ * The tree is built with the same bounds the CollisionHandler uses.
+ */
+void collisionBenchmarks(Bench& bench) {
+    for (const int n : BENCH_COUNTS) {
+        std::vector<Entity> entities;
+        Quadtree tree(0, {0, 0, MAP_WIDTH, MAP_HEIGHT});
+
+        bench.run("quadtree_insert", n, [&]{
+            entities = makeEntities(bench, n);
+        }, [&]{
+            tree.clear();
+            for (auto& e : entities) {
+                tree.insert(&e);
+            }
+        });
+
+        bench.run("quadtree_retrieve", n, [&]{
+            entities = makeEntities(bench, n);
+            tree.clear();
+            for (auto& e : entities) {
+                tree.insert(&e);
+            }
+        }, [&]{
+            size_t found = 0;
+            for (const auto& e : entities) {
+                found += tree.retrieve(&e).size();
+            }
+            volatile size_t sink = found;
+            (void)sink;
+        });
+
+        CollisionHandler ch;
+        bench.run("detect_movement_collision", n, [&]{
+            entities = makeEntities(bench, n);
+            ch = CollisionHandler();
+            for (auto& e : entities) {
+                ch.quadtreeZombie.insert(&e);
+            }
+        }, [&]{
+            int hits = 0;
+            for (const auto& e : entities) {
+                hits += ch.detectMovementCollision(ch.getQuadTreeEntities(ch.quadtreeZombie, &e), &e);
+            }
+            volatile int sink = hits;
+            (void)sink;
+        });
+
+        // rays from random points, plus a shotgun blast from each ray start in the ray's direction
+        std::vector<std::pair<SDL_Point, SDL_Point>> rays;
+        std::vector<std::vector<SDL_Point>> blasts;
+        auto populate = [&]{
+            std::uniform_int_distribution<int> pos(0, MAP_WIDTH);
+            std::uniform_real_distribution<double> angle(0, 2 * M_PI);
+            entities = makeEntities(bench, n);
+            ch = CollisionHandler();
+            for (auto& e : entities) {
+                ch.quadtreeZombie.insert(&e);
+            }
+            rays.clear();
+            blasts.clear();
+            for (int i = 0; i < BENCH_RAYS; ++i) {
+                const SDL_Point start = {pos(bench.rng()), pos(bench.rng())};
+                const double a = angle(bench.rng());
+                rays.push_back({start, {static_cast<int>(start.x + 800 * cos(a)), static_cast<int>(start.y + 800 * sin(a))}});
+
+                std::vector<SDL_Point> ends;
+                for (int p = 0; p < ShotgunVars::PELLETS; ++p) {
+                    const double pa = a + (ShotgunVars::SPREAD * (p / (ShotgunVars::PELLETS - 1.0) - 0.5)) * M_PI / 180;
+                    ends.push_back({static_cast<int>(start.x + ShotgunVars::RANGE * cos(pa)),
+                        static_cast<int>(start.y + ShotgunVars::RANGE * sin(pa))});
+                }
+                blasts.push_back(ends);
+            }
+        };
+
+        bench.run("raycast", n, populate, [&]{
+            size_t hits = 0;
+            for (const auto& ray : rays) {
+                hits += ch.raycast(ray.first, ray.second, 2).size();
+            }
+            volatile size_t sink = hits;
+            (void)sink;
+        });
+
+        bench.run("shotgun_per_pellet", n, populate, [&]{
+            size_t hits = 0;
+            for (size_t i = 0; i < rays.size(); ++i) {
+                for (const auto& end : blasts[i]) {
+                    hits += ch.raycast(rays[i].first, end).size();
+                }
+            }
+            volatile size_t sink = hits;
+            (void)sink;
+        });
+
+        bench.run("shotgun_batched", n, populate, [&]{
+            size_t hits = 0;
+            for (size_t i = 0; i < rays.size(); ++i) {
+                hits += ch.raycast(rays[i].first, blasts[i]).size();
+            }
+            volatile size_t sink = hits;
+            (void)sink;
+        });
+    }
+}
@@ -0,0 +1,124 @@
+#include <cmath>
+#include <vector>
+
+#include "Bench.h"
+#include "../game/GameManager.h"
+#include "../sprites/Animation.h"
+#include "../sprites/RenderQueue.h"
+#include "../sprites/Renderer.h"
+
+// frames of the scripted camera pan
+constexpr int BENCH_FRAMES = 8;
+
+// zombies on the map while the frames are drawn
+constexpr int BENCH_FRAME_ZOMBIES = 2000;
+
+// map pixels the camera pans and animation ms that pass between two frames
+constexpr int BENCH_PAN = 160;
+constexpr uint32_t BENCH_FRAME_MS = 16;
+
+// FNV-1a of the visible pixels of every row, the padding at the end of a row is skipped
+static uint32_t hashSurface(const SDL_Surface *surface) {
+    uint32_t hash = 2166136261u;
+    const Uint8 *row = static_cast<const Uint8 *>(surface->pixels);
+    const int rowBytes = surface->w * surface->format->BytesPerPixel;
+
+    for (int y = 0; y < surface->h; ++y, row += surface->pitch) {
+        for (int x = 0; x < rowBytes; ++x) {
+            hash = (hash ^ row[x]) * 16777619u;
+        }
+    }
+    return hash;
+}
+
+// FNV-1a of the frame's sprites in the order they were queued, field by field
+static uint32_t hashCommands(const std::vector<DrawCommand>& commands) {
+    uint32_t hash = 2166136261u;
+    const auto mix = [&](const int32_t value) {
+        for (int shift = 0; shift < 32; shift += 8) {
+            hash = (hash ^ ((value >> shift) & 0xFF)) * 16777619u;
+        }
+    };
+    for (const auto& c : commands) {
+        mix(static_cast<int32_t>(c.layer));
+        mix(static_cast<int32_t>(c.texture));
+        mix(c.dest.x);
+        mix(c.dest.y);
+        mix(c.dest.w);
+        mix(c.dest.h);
+        mix(c.clip.x);
+        mix(c.clip.y);
+        mix(c.clip.w);
+        mix(c.clip.h);
+        mix(lroundf(c.angle * 100));
+    }
+    return hash;
+}
+
+/**
+ * Scripted frames drawn into the offscreen surface given to Renderer::setSurface.
+ * Every frame the camera pans BENCH_PAN further across a seeded horde and the animation
+ * clock is set to the frame's moment, then the frame is composed the way the match does it,
+ * ground tiles then renderObjects, and drawn by the software renderer.
+ * The compose time of each frame is timed and two FNV-1a hashes are reported: draw_hash of
+ * the sprites queued, which bin/bench -g checks against the golden values, and fnv1a of the
+ * pixels, which also depends on the SDL build rasterising them. Animation phases count from
+ * the horde's first zombie and zombies are spawned from the reseeded generator, so a frame
+ * only hashes differently if what is drawn changed, whichever benchmarks ran before it.
+ */
+void frameBenchmarks(Bench& bench) {
+    SDL_Surface *surface = Renderer::getSurface();
+    SDL_Renderer *renderer = Renderer::getRenderer();
+    const bool drawn = surface != nullptr && renderer != nullptr;
+
+    RenderQueue queue;
+    // queues the frame the way the match does, ground tiles then renderObjects
+    const auto compose = [&](const SDL_Rect& cam) {
+        for (int x = cam.x / TEXTURE_SIZE * TEXTURE_SIZE; x < cam.x + cam.w; x += TEXTURE_SIZE) {
+            for (int y = cam.y / TEXTURE_SIZE * TEXTURE_SIZE; y < cam.y + cam.h; y += TEXTURE_SIZE) {
+                queue.push(RenderLayer::BACKGROUND, TEXTURES::BARREN, {x - cam.x, y - cam.y, TEXTURE_SIZE, TEXTURE_SIZE});
+            }
+        }
+        GameManager::instance()->renderObjects(cam, queue);
+    };
+
+    for (int frame = 0; frame < BENCH_FRAMES; ++frame) {
+        const std::string name = "frame_compose_" + std::to_string(frame);
+        if (!bench.enabled(name)) {
+            continue;
+        }
+
+        const SDL_Rect cam = {(MAP_WIDTH - BENCH_VIEW_W) / 2 + (frame - BENCH_FRAMES / 2) * BENCH_PAN,
+            (MAP_HEIGHT - BENCH_VIEW_H) / 2, BENCH_VIEW_W, BENCH_VIEW_H};
+        const auto populate = [&]{
+            clearZombies();
+            Animations::setPhaseOrigin(GameManager::instance()->generateID() + 1);
+            spawnZombies(bench, BENCH_FRAME_ZOMBIES);
+            GameManager::instance()->updateCollider();
+            Animations::setClock(frame * BENCH_FRAME_MS);
+        };
+
+        if (drawn) {
+            bench.run(name, BENCH_FRAME_ZOMBIES, populate, [&]{
+                SDL_RenderClear(renderer);
+                compose(cam);
+                queue.flush(renderer);
+                // the software renderer batches its draws until the frame is presented
+                SDL_RenderPresent(renderer);
+            });
+            bench.metric(name, BENCH_FRAME_ZOMBIES, "fnv1a", hashSurface(surface));
+            bench.metric(name, BENCH_FRAME_ZOMBIES, "draw_calls", queue.getDrawCalls());
+        }
+
+        // the sprites queued need no renderer, they are checked even where nothing can be drawn
+        bench.rng().seed(BENCH_SEED);
+        populate();
+        compose(cam);
+        bench.expect(name, BENCH_FRAME_ZOMBIES, "draw_hash", hashCommands(queue.getCommands()));
+        queue.clear();
+    }
+
+    clearZombies();
+    GameManager::instance()->updateCollider();
+    Animations::setPhaseOrigin(0);
+}
@@ -0,0 +1,77 @@
+#include "Bench.h"
+#include "../game/GameManager.h"
+
+void spawnZombies(Bench& bench, const int n) {
+    std::uniform_real_distribution<float> pos(0, MAP_WIDTH - ZOMBIE_WIDTH);
+    for (int i = 0; i < n; ++i) {
+        const float x = pos(bench.rng());
+        const float y = pos(bench.rng());
+        GameManager::instance()->createZombie(x, y);
+    }
+}
+
+void clearZombies() {
+    GameManager::instance()->getZombies().clear();
+}
+
+// ticks simulated by zombie_churn before the zombie count is reported
+constexpr int BENCH_CHURN_TICKS = 1000;
+// seconds per zombie_churn tick
+constexpr float BENCH_CHURN_DELTA = 1.0f / 60;
+
+/**
+ * GameManager::updateCollider and GameManager::createZombieWave.
+ * createZombieWave spawns 7 zombies per wave, so the entity count is waves * 7.
+ * zombie_churn is one tick of a long session, a wave spawns while as many of the oldest
+ * zombies are killed and despawned, so the horde should stay at n plus the corpses of the
+ * last ZOMBIE_DEATH_MS.
+ */
+void managerBenchmarks(Bench& bench) {
+    for (const int n : BENCH_COUNTS) {
+        bench.run("update_collider", n, [&]{
+            clearZombies();
+            spawnZombies(bench, n);
+        }, []{
+            GameManager::instance()->updateCollider();
+        });
+        clearZombies();
+        GameManager::instance()->updateCollider();
+
+        const int waves = n / 7;
+        bench.run("create_zombie_wave", waves * 7, nullptr, [&]{
+            GameManager::instance()->createZombieWave(waves);
+        }, []{
+            clearZombies();
+        });
+
+        // one tick of spawning and killing as many zombies
+        auto churn = []{
+            GameManager *gm = GameManager::instance();
+            gm->createZombieWave(1);
+            int killed = 0;
+            for (auto it = gm->getZombies().begin(); it != gm->getZombies().end() && killed < 7; ++it) {
+                if (it->second.getState() != ZombieState::ZOMBIE_DIE) {
+                    gm->getDamageQueue().push(it->first, ZOMBIE_INIT_HP);
+                    ++killed;
+                }
+            }
+            gm->updateCollider();
+            gm->applyDamage();
+            gm->despawnDead(BENCH_CHURN_DELTA);
+        };
+
+        bench.run("zombie_churn", n, [&]{
+            clearZombies();
+            spawnZombies(bench, n);
+        }, churn);
+
+        if (bench.enabled("zombie_churn")) {
+            for (int i = 0; i < BENCH_CHURN_TICKS; ++i) {
+                churn();
+            }
+            bench.metric("zombie_churn", n, "zombies_after_ticks", GameManager::instance()->getZombies().size());
+        }
+        clearZombies();
+        GameManager::instance()->updateCollider();
+    }
+}
@@ -0,0 +1,54 @@
+#include <vector>
+
+#include "Bench.h"
+#include "../game/GameManager.h"
+#include "../net/MarinePredictor.h"
+#include "../net/NetProtocol.h"
+#include "../net/Snapshot.h"
+
+// commands a reconcile replays, a 500ms round trip at the server's tick rate
+constexpr int BENCH_REPLAY_TICKS = 16;
+
+/**
+ * MarinePredictor::reconcile in a level full of zombies.
+ * A marine in the middle of the map is predicted BENCH_REPLAY_TICKS commands walking a square,
+ * then every reconcile rewinds it to where it started and replays them all, through the same
+ * collision checks GameManager::updateMarines runs. matches is whether the replay ends where
+ * the prediction did.
+ */
+void predictionBenchmarks(Bench& bench) {
+    for (const int n : BENCH_COUNTS) {
+        clearZombies();
+        spawnZombies(bench, n);
+
+        const int32_t id = GameManager::instance()->createMarine();
+        Marine& marine = GameManager::instance()->getMarine(id);
+        marine.setPosition(MAP_WIDTH / 2, MAP_HEIGHT / 2);
+        GameManager::instance()->updateCollider();
+        CollisionHandler& ch = GameManager::instance()->getCollisionHandler();
+
+        const EntityState start = {id, EntityKind::MARINE, quantisePosition(marine.getX()),
+            quantisePosition(marine.getY()), 0, 0, 0, 0};
+        MarinePredictor predictor;
+        const float delta = 1.0f / SERVER_TICK_RATE;
+        const int sides[4][2] = {{1, 0}, {0, 1}, {-1, 0}, {0, -1}};
+        for (int t = 0; t < BENCH_REPLAY_TICKS; ++t) {
+            const int *side = sides[t * 4 / BENCH_REPLAY_TICKS];
+            predictor.predict(marine, side[0], side[1], 0, delta, ch);
+        }
+        const float predictedX = marine.getX();
+        const float predictedY = marine.getY();
+
+        // the server has applied none of them yet, sequence 0
+        int replayed = 0;
+        bench.run("prediction_replay", n, nullptr, [&]{
+            replayed = predictor.reconcile(marine, start, 0, ch);
+        });
+        bench.metric("prediction_replay", n, "ticks", replayed);
+        bench.metric("prediction_replay", n, "matches",
+            marine.getX() == predictedX && marine.getY() == predictedY);
+
+        GameManager::instance()->deleteMarine(id);
+    }
+    clearZombies();
+}
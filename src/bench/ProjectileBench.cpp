@@ -0,0 +1,50 @@
+#include <cmath>
+
+#include "Bench.h"
+#include "../game/GameManager.h"
+#include "../inventory/weapons/RocketLauncher.h"
+
+// projectiles kept alive, the load the projectile system has to sustain at 60Hz
+constexpr int BENCH_PROJECTILES = 10000;
+
+// one simulation step at 60Hz, in seconds
+constexpr float BENCH_TICK = 1.0f / 60;
+
+/**
+ * GameManager::updateProjectiles, applyDamage and despawnDead with BENCH_PROJECTILES in flight against a growing horde.
+ * Every fourth projectile is a rocket. Projectiles that expired during the previous tick are
+ * replaced before each tick so the pool stays full, which is included in the timing.
+ */
+void projectileBenchmarks(Bench& bench) {
+    ProjectilePool& pool = GameManager::instance()->getProjectilePool();
+    std::uniform_real_distribution<float> pos(0, MAP_WIDTH);
+    std::uniform_real_distribution<float> angle(0, 2 * M_PI);
+
+    // tops the pool back up to BENCH_PROJECTILES
+    auto refill = [&]{
+        for (int i = pool.size(); i < BENCH_PROJECTILES; ++i) {
+            const float a = angle(bench.rng());
+            const int rAOE = i % 4 == 0 ? RocketLauncherVars::AOE : 0;
+            pool.spawn(pos(bench.rng()), pos(bench.rng()), RocketLauncherVars::SPEED * cos(a),
+                RocketLauncherVars::SPEED * sin(a), MAP_WIDTH, 1, rAOE);
+        }
+    };
+
+    for (const int n : BENCH_COUNTS) {
+        bench.run("projectile_update", n, [&]{
+            pool.clear();
+            clearZombies();
+            spawnZombies(bench, n);
+            GameManager::instance()->updateCollider();
+        }, [&]{
+            refill();
+            GameManager::instance()->updateProjectiles(BENCH_TICK);
+            GameManager::instance()->applyDamage();
+            GameManager::instance()->despawnDead(BENCH_TICK);
+        });
+    }
+
+    pool.clear();
+    clearZombies();
+    GameManager::instance()->updateCollider();
+}
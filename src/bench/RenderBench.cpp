@@ -0,0 +1,140 @@
+#include <algorithm>
+#include <stdio.h>
+
+#include "Bench.h"
+#include "../game/GameManager.h"
+#include "../sprites/RenderQueue.h"
+#include "../sprites/Renderer.h"
+
+// textures the sprites are spread over, roughly what a crowded match frame binds
+const std::vector<TEXTURES> BENCH_TEXTURES = {TEXTURES::BABY_ZOMBIE, TEXTURES::MARINE, TEXTURES::CONCRETE,
+    TEXTURES::BARREN, TEXTURES::MAP_OBJECTS};
+
+/**
+ * RenderQueue::flush with n sprites pushed in entity order, interleaving textures and layers
+ * the way GameManager::renderObjects does. Draw calls per flush are reported as a metric,
+ * one per layer when every texture is on the same atlas page.
+ */
+void renderBenchmarks(Bench& bench) {
+    // packs the sprites into the atlas the queue draws from
+    Renderer::loadSprites();
+
+    RenderQueue queue;
+    std::uniform_int_distribution<int> pos(0, MAP_WIDTH);
+    std::uniform_int_distribution<int> angle(0, 359);
+    std::vector<DrawCommand> sprites;
+
+    for (const int n : BENCH_COUNTS) {
+        const std::string name = "render_queue_flush";
+        if (!bench.enabled(name)) {
+            continue;
+        }
+
+        bench.run(name, n, [&]{
+            sprites.clear();
+            for (int i = 0; i < n; ++i) {
+                const RenderLayer layer = static_cast<RenderLayer>(i % (static_cast<int>(RenderLayer::PROJECTILES) + 1));
+                sprites.push_back({layer, BENCH_TEXTURES[i % BENCH_TEXTURES.size()],
+                    {pos(bench.rng()), pos(bench.rng()), MARINE_SIZE, MARINE_SIZE}, {0, 0, 0, 0},
+                    static_cast<float>(angle(bench.rng()))});
+            }
+        }, [&]{
+            for (const auto& s : sprites) {
+                queue.push(s.layer, s.texture, s.dest, s.angle);
+            }
+            queue.flush(Renderer::instance()->getRenderer());
+        });
+        bench.metric(name, n, "draw_calls", queue.getDrawCalls());
+    }
+
+    /*
+     * Renderer::getRegion for n sprites of the ids drawn in a match, the lookup every
+     * draw of a sprite makes.
+     */
+    std::vector<int> ids;
+    // a texture that failed to load has no region, checked once so the timed loop can dereference them
+    const bool regionsLoaded = std::all_of(BENCH_TEXTURES.begin(), BENCH_TEXTURES.end(), [](const TEXTURES t) {
+        return Renderer::getRegion(static_cast<int>(t)) != nullptr;
+    });
+    for (const int n : BENCH_COUNTS) {
+        const std::string name = "texture_lookup";
+        if (!bench.enabled(name)) {
+            continue;
+        }
+        if (!regionsLoaded) {
+            fprintf(stderr, "sprites missing from the atlas, %s skipped\n", name.c_str());
+            break;
+        }
+
+        volatile int width = 0; // keeps the lookups from being optimised out
+        bench.run(name, n, [&]{
+            ids.clear();
+            for (int i = 0; i < n; ++i) {
+                ids.push_back(static_cast<int>(BENCH_TEXTURES[bench.rng()() % BENCH_TEXTURES.size()]));
+            }
+        }, [&]{
+            int sum = 0;
+            for (const int id : ids) {
+                sum += Renderer::getRegion(id)->rect.w;
+            }
+            width = sum;
+        });
+    }
+
+    /*
+     * GameManager::renderObjects with n zombies spread over the map and the camera in its
+     * centre, the queue is emptied untimed. Sprites queued and culled are reported as metrics.
+     */
+    const SDL_Rect cam = {(MAP_WIDTH - BENCH_VIEW_W) / 2, (MAP_HEIGHT - BENCH_VIEW_H) / 2, BENCH_VIEW_W, BENCH_VIEW_H};
+    for (const int n : BENCH_COUNTS) {
+        const std::string name = "render_objects_cull";
+        if (!bench.enabled(name)) {
+            continue;
+        }
+
+        bench.run(name, n, [&]{
+            clearZombies();
+            spawnZombies(bench, n);
+            GameManager::instance()->updateCollider();
+        }, [&]{
+            GameManager::instance()->renderObjects(cam, queue);
+        }, [&]{
+            queue.flush(Renderer::instance()->getRenderer());
+        });
+        const RenderStats& stats = GameManager::instance()->getRenderStats();
+        bench.metric(name, n, "submitted", stats.submitted);
+        bench.metric(name, n, "culled", stats.culled);
+        bench.metric(name, n, "degraded", stats.degraded);
+    }
+
+    /*
+     * The same with all n zombies crowded into the camera, the horde at the base. Past
+     * LOD_DENSITY the farthest are drawn as impostors or merged, reported as degraded.
+     */
+    std::uniform_int_distribution<int> viewX(cam.x, cam.x + cam.w - ZOMBIE_WIDTH);
+    std::uniform_int_distribution<int> viewY(cam.y, cam.y + cam.h - ZOMBIE_HEIGHT);
+    for (const int n : BENCH_COUNTS) {
+        const std::string name = "render_objects_horde";
+        if (!bench.enabled(name)) {
+            continue;
+        }
+
+        bench.run(name, n, [&]{
+            clearZombies();
+            for (int i = 0; i < n; ++i) {
+                GameManager::instance()->createZombie(viewX(bench.rng()), viewY(bench.rng()));
+            }
+            GameManager::instance()->updateCollider();
+        }, [&]{
+            GameManager::instance()->renderObjects(cam, queue);
+        }, [&]{
+            queue.flush(Renderer::instance()->getRenderer());
+        });
+        const RenderStats& stats = GameManager::instance()->getRenderStats();
+        bench.metric(name, n, "submitted", stats.submitted);
+        bench.metric(name, n, "degraded", stats.degraded);
+    }
+
+    clearZombies();
+    GameManager::instance()->updateCollider();
+}
@@ -0,0 +1,80 @@
+#include <algorithm>
+#include <vector>
+
+#include "Bench.h"
+#include "../game/GameManager.h"
+#include "../net/NetProtocol.h"
+#include "../net/Snapshot.h"
+
+// one in this many zombies turns between the two snapshots, the rest keep walking or standing
+constexpr int BENCH_TURN_ODDS = 20;
+
+static bool sameEntities(const Snapshot& a, const Snapshot& b) {
+    return a.entities.size() == b.entities.size()
+        && std::equal(a.entities.begin(), a.entities.end(), b.entities.begin(), sameState);
+}
+
+/**
+ * Snapshot capture and the delta codec at a server tick.
+ * The baseline is the horde as spawned, the current snapshot one tick later with every zombie
+ * stepped by its speed in one of the eight directions or standing, and a few of them turned.
+ * bytes_per_entity is what one client is sent per entity per tick, in full and as a delta.
+ */
+void snapshotBenchmarks(Bench& bench) {
+    for (const int n : BENCH_COUNTS) {
+        Snapshot baseline;
+        Snapshot current;
+        Snapshot decoded;
+        SnapshotCodec codec;
+        BitWriter full;
+        BitWriter delta;
+
+        clearZombies();
+        spawnZombies(bench, n);
+        captureSnapshot(1, baseline);
+
+        const float step = static_cast<float>(ZOMBIE_VELOCITY) / SERVER_TICK_RATE;
+        std::uniform_int_distribution<int> heading(-1, 1);
+        std::uniform_int_distribution<int> turn(0, BENCH_TURN_ODDS - 1);
+        for (auto& z : GameManager::instance()->getZombies()) {
+            z.second.setPosition(z.second.getX() + heading(bench.rng()) * step,
+                z.second.getY() + heading(bench.rng()) * step);
+            if (turn(bench.rng()) == 0) {
+                z.second.setCurDir(static_cast<ZombieDirection>(turn(bench.rng()) % 8));
+            }
+        }
+        captureSnapshot(2, current);
+        const double entities = current.entities.size();
+
+        bench.run("snapshot_capture", n, nullptr, [&]{
+            captureSnapshot(2, current);
+        });
+
+        bench.run("snapshot_encode_full", n, nullptr, [&]{
+            full.clear();
+            codec.encode(current, nullptr, full);
+        });
+        bench.metric("snapshot_encode_full", n, "bytes_per_entity", full.bytes().size() / entities);
+
+        bench.run("snapshot_encode_delta", n, nullptr, [&]{
+            delta.clear();
+            codec.encode(current, &baseline, delta);
+        });
+        bench.metric("snapshot_encode_delta", n, "bytes_per_entity", delta.bytes().size() / entities);
+        bench.metric("snapshot_encode_delta", n, "packets",
+            (delta.bytes().size() + STATE_PAYLOAD_SIZE - 1) / STATE_PAYLOAD_SIZE);
+
+        bench.run("snapshot_decode_full", n, nullptr, [&]{
+            BitReader in(full.bytes().data(), full.bytes().size());
+            codec.decode(in, nullptr, decoded);
+        });
+        bench.metric("snapshot_decode_full", n, "matches", sameEntities(decoded, current));
+
+        bench.run("snapshot_decode_delta", n, nullptr, [&]{
+            BitReader in(delta.bytes().data(), delta.bytes().size());
+            codec.decode(in, &baseline, decoded);
+        });
+        bench.metric("snapshot_decode_delta", n, "matches", sameEntities(decoded, current));
+    }
+    clearZombies();
+}
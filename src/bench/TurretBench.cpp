@@ -0,0 +1,111 @@
+#include <vector>
+
+#include "Bench.h"
+#include "../game/GameManager.h"
+#include "../turrets/TargetKernel.h"
+
+// turrets placed around the base, matches the load the match state is tuned for
+constexpr int BENCH_TURRETS = 30;
+
+/**
+ * Turret::targetScanTurret for BENCH_TURRETS turrets against a growing horde.
+ * turret_target_scan is the per frame cost with sticky targets, turret_target_acquire
+ * forces every turret to search for a new target each iteration and turret_update_acquire
+ * does the same through the batched GameManager::updateTurrets. turret_update_corners spreads
+ * the turrets over the four corners of the map, far apart groups that must not share a query.
+ * turret_kernel_scalar and turret_kernel_simd time nearestTargets on its own against
+ * its scalar reference, with every zombie as a candidate.
+ */
+void turretBenchmarks(Bench& bench) {
+    std::vector<int32_t> turrets;
+
+    // removes the turrets of the previous run
+    auto clearTurrets = [&]{
+        for (const auto id : turrets) {
+            GameManager::instance()->deleteTurret(id);
+        }
+        turrets.clear();
+    };
+
+    for (const int n : BENCH_COUNTS) {
+        auto populate = [&]{
+            std::uniform_real_distribution<float> pos(MAP_WIDTH / 4, MAP_WIDTH * 3 / 4);
+            clearTurrets();
+            clearZombies();
+            spawnZombies(bench, n);
+            for (int i = 0; i < BENCH_TURRETS; ++i) {
+                const float x = pos(bench.rng());
+                const float y = pos(bench.rng());
+                turrets.push_back(GameManager::instance()->createTurret(x, y));
+            }
+            GameManager::instance()->updateCollider();
+        };
+
+        bench.run("turret_target_scan", n, populate, [&]{
+            for (const auto id : turrets) {
+                GameManager::instance()->getTurret(id).targetScanTurret();
+            }
+        });
+
+        bench.run("turret_target_acquire", n, populate, [&]{
+            for (const auto id : turrets) {
+                Turret& turret = GameManager::instance()->getTurret(id);
+                turret.releaseTarget();
+                turret.targetScanTurret();
+            }
+        });
+
+        bench.run("turret_update_acquire", n, populate, [&]{
+            for (const auto id : turrets) {
+                GameManager::instance()->getTurret(id).releaseTarget();
+            }
+            GameManager::instance()->updateTurrets(0);
+        });
+
+        bench.run("turret_update_corners", n, [&]{
+            std::uniform_real_distribution<float> pos(0, MAP_WIDTH / 8);
+            clearTurrets();
+            clearZombies();
+            spawnZombies(bench, n);
+            for (int i = 0; i < BENCH_TURRETS; ++i) {
+                const float x = pos(bench.rng()) + (i % 2) * MAP_WIDTH * 7 / 8;
+                const float y = pos(bench.rng()) + (i / 2 % 2) * MAP_HEIGHT * 7 / 8;
+                turrets.push_back(GameManager::instance()->createTurret(x, y));
+            }
+            GameManager::instance()->updateCollider();
+        }, [&]{
+            for (const auto id : turrets) {
+                GameManager::instance()->getTurret(id).releaseTarget();
+            }
+            GameManager::instance()->updateTurrets(0);
+        });
+
+        TurretPack turretPack;
+        ZombiePack zombiePack;
+        std::vector<int32_t> nearest;
+
+        auto pack = [&]{
+            std::uniform_real_distribution<float> pos(0, MAP_WIDTH);
+            turretPack.clear();
+            zombiePack.clear();
+            for (int i = 0; i < BENCH_TURRETS; ++i) {
+                turretPack.push(pos(bench.rng()), pos(bench.rng()), 400.0f);
+            }
+            for (int i = 0; i < n; ++i) {
+                zombiePack.push(pos(bench.rng()), pos(bench.rng()), i);
+            }
+        };
+
+        bench.run("turret_kernel_scalar", n, pack, [&]{
+            nearestTargetsScalar(turretPack, zombiePack, nearest);
+        });
+
+        bench.run("turret_kernel_simd", n, pack, [&]{
+            nearestTargets(turretPack, zombiePack, nearest);
+        });
+    }
+
+    clearTurrets();
+    clearZombies();
+    GameManager::instance()->updateCollider();
+}
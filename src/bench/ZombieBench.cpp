@@ -0,0 +1,38 @@
+#include <vector>
+
+#include "Bench.h"
+#include "../game/GameManager.h"
+#include "../game/GameMap.h"
+
+// number of zombies asking for a path per iteration
+static const std::vector<int> PATH_COUNTS = {1, 10, 100};
+
+/**
+ * Zombie::generatePath from random open tiles to the base.
+ */
+void zombieBenchmarks(Bench& bench) {
+    for (const int n : PATH_COUNTS) {
+        std::vector<Point> starts;
+        Zombie zombie(0, {0, 0, ZOMBIE_WIDTH, ZOMBIE_HEIGHT}, {0, 0, ZOMBIE_WIDTH, ZOMBIE_HEIGHT},
+            {0, 0, ZOMBIE_WIDTH, ZOMBIE_HEIGHT}, {0, 0, ZOMBIE_WIDTH, ZOMBIE_HEIGHT});
+
+        bench.run("zombie_generate_path", n, [&]{
+            std::uniform_int_distribution<int> tile(1, ROWS - 2);
+            starts.clear();
+            while (static_cast<int>(starts.size()) < n) {
+                const int row = tile(bench.rng());
+                const int col = tile(bench.rng());
+                if (gameMap[row][col] == 0) {
+                    starts.emplace_back(col * (MAP_WIDTH / COLS), row * (MAP_HEIGHT / ROWS));
+                }
+            }
+        }, [&]{
+            size_t steps = 0;
+            for (const auto& p : starts) {
+                steps += zombie.generatePath(p).size();
+            }
+            volatile size_t sink = steps;
+            (void)sink;
+        });
+    }
+}
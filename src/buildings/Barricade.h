@@ -28,6 +28,7 @@ public:
     bool isPlaced();
     bool checkPlaceablePosition(const float,const float,const float,const float, CollisionHandler&);
     void placeBarricade();
+    int getHealth() const {return health;}
 
 private:
     int health;
@@ -1,13 +1,19 @@
 #include "Quadtree.h"
 #include "CollisionHandler.h"
 #include "../player/Marine.h"
+#include "../buildings/Base.h"
 #include "../log/log.h"
 #include <iostream>
 #include <cassert>
+#include <algorithm>
+#include <cmath>
 
-CollisionHandler::CollisionHandler() : quadtreeMarine(0, {0,0,2000,2000}), quadtreeZombie(0, {0,0,2000,2000}),
-        quadtreeBarricade(0, {0,0,2000,2000}),quadtreeTurret(0, {0,0,2000,2000}),
-        quadtreeWall(0, {0,0,2000,2000}), quadtreePickUp(0, {0,0,2000,2000}), quadtreeObj(0, {0,0,2000,2000}) {
+// the quadtrees cover the whole map so they split evenly over it
+static constexpr SDL_Rect MAP_BOUNDS = {0, 0, MAP_WIDTH, MAP_HEIGHT};
+
+CollisionHandler::CollisionHandler() : quadtreeMarine(0, MAP_BOUNDS), quadtreeZombie(0, MAP_BOUNDS),
+        quadtreeBarricade(0, MAP_BOUNDS),quadtreeTurret(0, MAP_BOUNDS),
+        quadtreeWall(0, MAP_BOUNDS), quadtreePickUp(0, MAP_BOUNDS), quadtreeObj(0, MAP_BOUNDS) {
 
 }
 
@@ -73,36 +79,129 @@ Entity *CollisionHandler::detectPickUpCollision(std::vector<Entity*> returnObjec
 }
 
 // Created by DericM 3/8/2017
-// TODO fix collision detection using new quadtrees
-std::priority_queue<const HitBox*> CollisionHandler::detectLineCollision(
-        Marine &marine, const int range) {
-
+// Casts a ray from the marine's centre in the direction it is facing.
+std::vector<RayHit> CollisionHandler::detectLineCollision(const Marine &marine, const int range, const int penetration) {
     const double degrees = marine.getAngle() - 90;
     const double radians = degrees * M_PI / 180;
     const int playerX = marine.getX() + (MARINE_WIDTH / 2);
     const int playerY = marine.getY() + (MARINE_HEIGHT / 2);
     const int deltaX  = range * cos(radians);
     const int deltaY  = range * sin(radians);
-    int aX, aY, bX, bY;
 
-    std::vector<Entity*> allEntities;
+    return raycast({playerX, playerY}, {playerX + deltaX, playerY + deltaY}, penetration);
+}
+
+// Casts pellets rays from the marine's centre, spread evenly over a cone of spread degrees
+// around the direction it is facing.
+std::vector<std::vector<RayHit>> CollisionHandler::detectSpreadCollision(const Marine &marine, const int range,
+        const int pellets, const double spread, const int penetration) {
+    const int playerX = marine.getX() + (MARINE_WIDTH / 2);
+    const int playerY = marine.getY() + (MARINE_HEIGHT / 2);
+    const double step = pellets > 1 ? spread / (pellets - 1) : 0;
+    const double first = marine.getAngle() - 90 - (pellets > 1 ? spread / 2 : 0);
+
+    std::vector<SDL_Point> ends;
+    ends.reserve(pellets);
+    for (int i = 0; i < pellets; ++i) {
+        const double radians = (first + step * i) * M_PI / 180;
+        ends.push_back({playerX + static_cast<int>(range * cos(radians)), playerY + static_cast<int>(range * sin(radians))});
+    }
+
+    return raycast({playerX, playerY}, ends, penetration);
+}
+
+// Narrowphase for a raycast, adds every candidate whose projectile hitbox the segment crosses
+static void rayHits(const std::vector<Entity *>& candidates, const SDL_Point& start, const SDL_Point& end,
+        std::vector<RayHit>& hits) {
+    for (const auto obj : candidates) {
+        int aX = start.x;
+        int aY = start.y;
+        int bX = end.x;
+        int bY = end.y;
+
+        if (SDL_IntersectRectAndLine(&obj->getProHitBox().getRect(), &aX, &aY, &bX, &bY)) {
+            const float distance = hypot(aX - start.x, aY - start.y);
+            hits.push_back({obj, obj->getId(), distance, {aX, aY}});
+        }
+    }
+}
+
+/**
+ * Narrowphase for one ray against broadphase candidates. Returns the zombies hit ordered by
+ * distance, at most penetration + 1 of them. Walls stop the ray, the wall that stopped it is
+ * the last hit returned.
+ */
+static std::vector<RayHit> castRay(const std::vector<Entity *>& zombies, const std::vector<Entity *>& walls,
+        const SDL_Point& start, const SDL_Point& end, const int penetration) {
+    std::vector<RayHit> wallHits;
+    rayHits(walls, start, end, wallHits);
 
-    //split into check for zombies (check for walls)
-    //allEntities = quadtreePro.objects;
+    std::vector<RayHit> hits;
+    rayHits(zombies, start, end, hits);
+
+    const auto closer = [](const RayHit& a, const RayHit& b) {
+        return a.distance < b.distance;
+    };
+    std::sort(hits.begin(), hits.end(), closer);
+
+    if (hits.size() > static_cast<size_t>(penetration + 1)) {
+        hits.resize(penetration + 1);
+    }
+
+    if (!wallHits.empty()) {
+        const RayHit wall = *std::min_element(wallHits.begin(), wallHits.end(), closer);
+        hits.erase(std::find_if(hits.begin(), hits.end(), [&wall](const RayHit& hit) {
+            return hit.distance > wall.distance;
+        }), hits.end());
+
+        if (hits.size() <= static_cast<size_t>(penetration)) {
+            hits.push_back(wall);
+        }
+    }
+
+    for (const auto& hit : hits) {
+        logv("Shot target %d at (%d, %d)\n", hit.id, hit.point.x, hit.point.y);
+    }
+    return hits;
+}
+
+// Casts a ray from start to end, only visiting the quadtree nodes the ray crosses.
+std::vector<RayHit> CollisionHandler::raycast(const SDL_Point& start, const SDL_Point& end,
+        const int penetration) const {
+    return castRay(quadtreeZombie.retrieve(start, end), quadtreeWall.retrieve(start, end), start, end, penetration);
+}
+
+/**
+ * Casts one ray from start to each of ends. The quadtrees are only walked once, for the box
+ * around all the rays, then every ray does its own narrowphase against the candidates in it.
+ */
+std::vector<std::vector<RayHit>> CollisionHandler::raycast(const SDL_Point& start, const std::vector<SDL_Point>& ends,
+        const int penetration) const {
+    std::vector<std::vector<RayHit>> hits;
+    if (ends.empty()) {
+        return hits;
+    }
+
+    SDL_Rect area = {start.x, start.y, 1, 1};
+    for (const auto& end : ends) {
+        const SDL_Rect point = {end.x, end.y, 1, 1};
+        SDL_UnionRect(&area, &point, &area);
+    }
 
-    std::priority_queue<const HitBox*> targetsInSights;
-    for (unsigned int x = 0, len = allEntities.size(); x < len; x++) {
-            aX = playerX;
-            aY = playerY;
-            bX = aX + deltaX;
-            bY = aY + deltaY;
+    // the nodes hold objects outside of area too, drop those once rather than once per ray
+    const auto outside = [&area](const Entity *obj) {
+        return !SDL_HasIntersection(&obj->getProHitBox().getRect(), &area);
+    };
+    std::vector<Entity *> zombies = quadtreeZombie.retrieve(area);
+    zombies.erase(std::remove_if(zombies.begin(), zombies.end(), outside), zombies.end());
+    std::vector<Entity *> walls = quadtreeWall.retrieve(area);
+    walls.erase(std::remove_if(walls.begin(), walls.end(), outside), walls.end());
 
-            if (SDL_IntersectRectAndLine(&(allEntities.at(x)->getProHitBox().getRect()), &aX, &aY , &bX, &bY)) {
-                logv("Shot target at (%d, %d)\n", aX, aY);
-                targetsInSights.push(&(allEntities.at(x)->getProHitBox()));
-            }
+    hits.reserve(ends.size());
+    for (const auto& end : ends) {
+        hits.push_back(castRay(zombies, walls, start, end, penetration));
     }
-    return targetsInSights;
+    return hits;
 }
 
 std::vector<Entity *> CollisionHandler::getQuadTreeEntities(Quadtree &q, const Entity *entity) {
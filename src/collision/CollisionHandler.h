@@ -3,10 +3,17 @@
 #include "HitBox.h"
 #include "Quadtree.h"
 #include <vector>
-#include <queue>
 
 class Marine;
 
+// An entity hit by a raycast
+struct RayHit {
+    Entity *entity;
+    int32_t id;
+    float distance; // from the start of the ray to where it enters the projectile hitbox
+    SDL_Point point; // where the ray enters the projectile hitbox
+};
+
 class CollisionHandler {
 public:
     CollisionHandler();
@@ -16,7 +23,12 @@ public:
     const HitBox *detectProjectileCollision(std::vector<Entity*> returnObjects, const Entity *entity); // Check for projectile collisions, return object if hits
     bool detectMovementCollision(const std::vector<Entity*> returnObjects, const Entity *entity); // // Check for collisions during movement
     Entity *detectPickUpCollision(std::vector<Entity*> returnObjects, const Entity *entity);//check for pick up collision, return object if can pick up
-    std::priority_queue<const HitBox*> detectLineCollision(Marine &marine, const int range);
+    std::vector<RayHit> detectLineCollision(const Marine &marine, const int range, const int penetration = 0); // shot from the marine's gun
+    std::vector<std::vector<RayHit>> detectSpreadCollision(const Marine &marine, const int range, const int pellets,
+        const double spread, const int penetration = 0); // shot spread over a cone from the marine's gun
+    std::vector<RayHit> raycast(const SDL_Point& start, const SDL_Point& end, const int penetration = 0) const; // hits along a segment, closest first
+    std::vector<std::vector<RayHit>> raycast(const SDL_Point& start, const std::vector<SDL_Point>& ends,
+        const int penetration = 0) const; // one raycast per end sharing a single broadphase
 
     std::vector<Entity *>getQuadTreeEntities(Quadtree &q,const Entity *entity); // General Collision handler, pass in quadtree check
 
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <array>
 #include <memory>
 #include "Quadtree.h"
@@ -104,6 +105,34 @@ void Quadtree::insert(Entity *entity) {
 }
 
 
+/**
+ * Removes every object in entities, which has to be sorted, from this node and its children.
+ * Objects move after they are inserted, so they may no longer be where getIndex would look
+ * for them. The whole tree is visited once instead, which for a batch of deaths is cheaper than
+ * searching for each of them.
+ */
+void Quadtree::remove(const std::vector<Entity *>& entities) {
+    if (entities.empty()) {
+        return;
+    }
+
+    const size_t before = objects.size();
+    objects.erase(std::remove_if(objects.begin(), objects.end(), [&entities](Entity *obj) {
+        return std::binary_search(entities.begin(), entities.end(), obj);
+    }), objects.end());
+    objectCounter -= before - objects.size();
+
+    if (nodes[0] == nullptr) {
+        return;
+    }
+
+    for (const auto& node : nodes) {
+        const unsigned int childBefore = node->getTreeSize();
+        node->remove(entities);
+        objectCounter -= childBefore - node->getTreeSize();
+    }
+}
+
 std::vector<Entity *> Quadtree::retrieve(const Entity *entity) {
     std::vector<Entity *> returnObjects;
     int index = getIndex(&(entity->getMoveHitBox()));
@@ -113,3 +142,107 @@ std::vector<Entity *> Quadtree::retrieve(const Entity *entity) {
     returnObjects.insert(std::end(returnObjects), std::begin(objects), std::end(objects));
     return returnObjects;
 }
+
+std::vector<Entity *> Quadtree::retrieve(const SDL_Rect& area) const {
+    std::vector<Entity *> returnObjects;
+    retrieve(area, returnObjects);
+    return returnObjects;
+}
+
+/**
+ * Collects the objects of every node whose quadrant overlaps area.
+ * Quadrants are split on the same midpoints getIndex uses and are open on their outer sides,
+ * since getIndex also files objects lying outside of the tree bounds into them.
+ */
+void Quadtree::retrieve(const SDL_Rect& area, std::vector<Entity *>& returnObjects) const {
+    returnObjects.insert(std::end(returnObjects), std::begin(objects), std::end(objects));
+
+    if (nodes[0] == nullptr) {
+        return;
+    }
+
+    const double verticalMidpoint = bounds.x + (bounds.w / 2);
+    const double horizontalMidpoint = bounds.y + (bounds.h / 2);
+
+    const bool left = area.x < verticalMidpoint;
+    const bool right = area.x + area.w > verticalMidpoint;
+    const bool top = area.y < horizontalMidpoint;
+    const bool bottom = area.y + area.h > horizontalMidpoint;
+
+    if (right && top) {
+        nodes[0]->retrieve(area, returnObjects);
+    }
+    if (left && top) {
+        nodes[1]->retrieve(area, returnObjects);
+    }
+    if (left && bottom) {
+        nodes[2]->retrieve(area, returnObjects);
+    }
+    if (right && bottom) {
+        nodes[3]->retrieve(area, returnObjects);
+    }
+}
+
+std::vector<Entity *> Quadtree::retrieve(const SDL_Point& start, const SDL_Point& end) const {
+    std::vector<Entity *> returnObjects;
+    retrieve(start, end, returnObjects);
+    return returnObjects;
+}
+
+/**
+ * Returns true if part of the segment lies in the quadrant on the given sides of the midpoints.
+ * Clips the segment against the two half planes bounding the quadrant (Liang-Barsky), the
+ * midpoint lines themselves count as part of both sides.
+ */
+static bool segmentInQuadrant(const SDL_Point& start, const SDL_Point& end, const bool right, const bool bottom,
+        const double verticalMidpoint, const double horizontalMidpoint) {
+    const double dx = end.x - start.x;
+    const double dy = end.y - start.y;
+    double tMin = 0;
+    double tMax = 1;
+
+    // keeps the part of the segment where p * t <= q
+    auto clip = [&](const double p, const double q) {
+        if (p == 0) {
+            return q >= 0;
+        }
+        const double t = q / p;
+        if (p < 0) {
+            tMin = std::max(tMin, t);
+        } else {
+            tMax = std::min(tMax, t);
+        }
+        return tMin <= tMax;
+    };
+
+    const bool inX = right ? clip(-dx, start.x - verticalMidpoint) : clip(dx, verticalMidpoint - start.x);
+    return inX && (bottom ? clip(-dy, start.y - horizontalMidpoint) : clip(dy, horizontalMidpoint - start.y));
+}
+
+/**
+ * Collects the objects of every node whose quadrant the segment passes through,
+ * so the cost grows with the nodes crossed rather than the size of the tree.
+ */
+void Quadtree::retrieve(const SDL_Point& start, const SDL_Point& end, std::vector<Entity *>& returnObjects) const {
+    returnObjects.insert(std::end(returnObjects), std::begin(objects), std::end(objects));
+
+    if (nodes[0] == nullptr) {
+        return;
+    }
+
+    const double verticalMidpoint = bounds.x + (bounds.w / 2);
+    const double horizontalMidpoint = bounds.y + (bounds.h / 2);
+
+    if (segmentInQuadrant(start, end, true, false, verticalMidpoint, horizontalMidpoint)) {
+        nodes[0]->retrieve(start, end, returnObjects);
+    }
+    if (segmentInQuadrant(start, end, false, false, verticalMidpoint, horizontalMidpoint)) {
+        nodes[1]->retrieve(start, end, returnObjects);
+    }
+    if (segmentInQuadrant(start, end, false, true, verticalMidpoint, horizontalMidpoint)) {
+        nodes[2]->retrieve(start, end, returnObjects);
+    }
+    if (segmentInQuadrant(start, end, true, true, verticalMidpoint, horizontalMidpoint)) {
+        nodes[3]->retrieve(start, end, returnObjects);
+    }
+}
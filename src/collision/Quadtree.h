@@ -9,7 +9,7 @@
 
 constexpr unsigned int BRANCHSIZE = 4;
 
-constexpr unsigned int MAX_OBJECTS = 1000;
+constexpr unsigned int MAX_OBJECTS = 64;
 constexpr unsigned int MAX_LEVELS = 50;
 
 class Quadtree {
@@ -24,11 +24,17 @@ public:
     unsigned int getTreeSize() const;
     int getIndex(const HitBox *pRect) const;
     void insert(Entity *entity);
+    void remove(const std::vector<Entity *>& entities); // removes all of them in one pass, entities must be sorted
     std::vector<Entity *> retrieve(const Entity *entity);
+    std::vector<Entity *> retrieve(const SDL_Rect& area) const; // every object that may overlap area
+    void retrieve(const SDL_Rect& area, std::vector<Entity *>& returnObjects) const; // appends them instead
+    std::vector<Entity *> retrieve(const SDL_Point& start, const SDL_Point& end) const; // every object that may touch the segment
 
     std::vector<Entity *> objects;
 
 private:
+    void retrieve(const SDL_Point& start, const SDL_Point& end, std::vector<Entity *>& returnObjects) const;
+
     unsigned int objectCounter;
     unsigned int level;
     SDL_Rect bounds;
@@ -0,0 +1,43 @@
+#include <algorithm>
+
+#include "SpatialGrid.h"
+
+SpatialGrid::SpatialGrid(const SDL_Rect& bounds, const int cellSize) : bounds(bounds), cellSize(cellSize),
+        cols((bounds.w + cellSize - 1) / cellSize), rows((bounds.h + cellSize - 1) / cellSize),
+        extentX(0), extentY(0), cells(cols * rows) {
+
+}
+
+void SpatialGrid::clear() {
+    for (auto& cell : cells) {
+        cell.clear();
+    }
+    extentX = 0;
+    extentY = 0;
+}
+
+// Cell containing (x, y), points outside the bounds go to the closest edge cell.
+int SpatialGrid::cellIndex(const int x, const int y) const {
+    const int col = std::min(std::max((x - bounds.x) / cellSize, 0), cols - 1);
+    const int row = std::min(std::max((y - bounds.y) / cellSize, 0), rows - 1);
+    return row * cols + col;
+}
+
+void SpatialGrid::insert(Entity *entity) {
+    const SDL_Rect& rect = entity->getProHitBox().getRect();
+    extentX = std::max(extentX, (rect.w + 1) / 2);
+    extentY = std::max(extentY, (rect.h + 1) / 2);
+    cells[cellIndex(rect.x + rect.w / 2, rect.y + rect.h / 2)].push_back(entity);
+}
+
+void SpatialGrid::retrieve(const SDL_Rect& area, std::vector<Entity *>& returnObjects) const {
+    const int first = cellIndex(area.x - extentX, area.y - extentY);
+    const int last = cellIndex(area.x + area.w + extentX, area.y + area.h + extentY);
+
+    for (int row = first / cols; row <= last / cols; ++row) {
+        for (int col = first % cols; col <= last % cols; ++col) {
+            const auto& cell = cells[row * cols + col];
+            returnObjects.insert(std::end(returnObjects), std::begin(cell), std::end(cell));
+        }
+    }
+}
@@ -0,0 +1,39 @@
+#ifndef SPATIALGRID_H
+#define SPATIALGRID_H
+
+#include <SDL2/SDL.h>
+#include <vector>
+
+#include "../basic/Entity.h"
+
+static constexpr int GRID_CELL_SIZE = 128; // width and height of a grid cell
+
+/*
+ * Uniform grid of entities, each filed once in the cell containing the centre of its projectile hitbox.
+ * Meant to be cleared and refilled every tick for workloads doing thousands of small queries,
+ * where the quadtree hands back every object stored in the nodes above the query.
+ * Queries are grown by the largest half extent inserted so entities reaching into a cell
+ * from a neighbour are still found.
+ */
+class SpatialGrid {
+public:
+    SpatialGrid(const SDL_Rect& bounds, const int cellSize = GRID_CELL_SIZE);
+    ~SpatialGrid() = default;
+
+    void clear(); // empties every cell, keeping their memory
+    void insert(Entity *entity);
+    void retrieve(const SDL_Rect& area, std::vector<Entity *>& returnObjects) const; // appends every entity that may overlap area
+
+private:
+    int cellIndex(const int x, const int y) const;
+
+    SDL_Rect bounds;
+    int cellSize;
+    int cols;
+    int rows;
+    int extentX; // largest half width inserted
+    int extentY; // largest half height inserted
+    std::vector<std::vector<Entity *>> cells;
+};
+
+#endif
@@ -2,6 +2,7 @@
 #include <random>
 #include <cassert>
 #include <utility>
+#include <array>
 #include "Node.h"
 #include "Zombie.h"
 #include "../game/GameManager.h"
@@ -14,6 +15,7 @@ Zombie::Zombie(int32_t id, const SDL_Rect &dest, const SDL_Rect &movementSize, c
         Movable(id, dest, movementSize, projectileSize, damageSize, ZOMBIE_VELOCITY),
         health(health), state(state), step(step), dir(dir), frame(frame) {
     logv("Create Zombie\n");
+    updateAnimation();
 }
 
 Zombie::~Zombie() {
@@ -47,8 +49,26 @@ void Zombie::attack() {
     // Do nothing for now
 }
 
+// Marks the zombie dead, GameManager stops colliding and updating it and despawns its corpse later.
 void Zombie::die() {
-    // Do nothing for now
+    setState(ZombieState::ZOMBIE_DIE);
+}
+
+/**
+ * Keeps the animation index in step with the zombie, only called when its state or
+ * direction changes. A zombie without a direction faces the screen.
+ */
+void Zombie::updateAnimation() {
+    // sheet row of every ZombieDirection, in enum order
+    static constexpr std::array<SheetRow, ANIMATION_DIRECTIONS> rows = {SheetRow::RIGHT, SheetRow::FRONT_RIGHT,
+        SheetRow::FRONT, SheetRow::FRONT_LEFT, SheetRow::LEFT, SheetRow::BACK_LEFT, SheetRow::BACK,
+        SheetRow::BACK_RIGHT};
+    // animation of every ZombieState, in enum order
+    static constexpr std::array<AnimationAction, ANIMATION_ACTIONS> actions = {AnimationAction::IDLE,
+        AnimationAction::WALK, AnimationAction::ATTACK, AnimationAction::DIE};
+
+    const SheetRow row = dir == ZombieDirection::DIR_INVALID ? SheetRow::FRONT : rows[static_cast<int>(dir)];
+    setAnimation(Animations::select(AnimationSheet::BABY_ZOMBIE, actions[static_cast<int>(state)], row));
 }
 
 /**
@@ -23,6 +23,7 @@ static constexpr int ZOMBIE_WIDTH    = 75;
 static constexpr int ZOMBIE_INIT_HP  = 100;
 static constexpr int ZOMBIE_VELOCITY = 150;
 static constexpr int ZOMBIE_FRAMES   = 30;
+static constexpr int ZOMBIE_DEATH_MS = 1000; // a dead zombie lies showing its death clip this long
 
 // block threshold - check if zombie is blocked
 static constexpr float BLOCK_THRESHOLD = 0.5;
@@ -125,6 +126,7 @@ public:
      */
     void setState(const ZombieState newState) {
         state = newState;
+        updateAnimation();
     }
 
     /**
@@ -136,6 +138,11 @@ public:
         return state;
     }
 
+    // returns the zombie's health, it dies once this reaches 0
+    int getHealth() const {
+        return health;
+    }
+
     /**
      * Get A* path
      * Fred Yang
@@ -161,6 +168,7 @@ public:
      */
     void setCurDir(const ZombieDirection d) {
         dir = d;
+        updateAnimation();
     }
 
     /**
@@ -191,6 +199,8 @@ public:
     }
 
 private:
+    void updateAnimation(); // picks the sheet animation of the current state and direction
+
     int health;         // health points of zombie
     std::string path;   // A* path zombie should follow
     ZombieState state;  // 0 - idle, 1 - move, 2 - attack, 3 - die
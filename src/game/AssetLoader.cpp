@@ -0,0 +1,168 @@
+#include <algorithm>
+
+#include "AssetLoader.h"
+#include "../audio/AudioManager.h"
+#include "../log/log.h"
+
+AssetLoader AssetLoader::sInstance;
+
+AssetLoader& AssetLoader::instance() {
+    return sInstance;
+}
+
+AssetLoader::~AssetLoader() {
+    stop();
+}
+
+/**
+ * Queues the menu's images first, then the match's images and the sounds, and starts one worker
+ * per core beyond the render thread's. Workers leave once the queue is empty.
+ */
+void AssetLoader::start() {
+    started = std::chrono::steady_clock::now();
+    if (!archive.open(ASSET_ARCHIVE)) {
+        logv("No asset archive, decoding the loose files\n");
+    }
+
+    const std::array<const std::vector<SpriteFile> *, ASSET_GROUPS> sprites = {&MENU_SPRITES, &MATCH_SPRITES};
+    for (int group = 0; group < ASSET_GROUPS; ++group) {
+        for (const auto& file : Renderer::spriteFiles(*sprites[group])) {
+            jobs.push_back({static_cast<AssetGroup>(group), AssetKind::IMAGE, file.first, file.second,
+                nullptr, nullptr, 0});
+        }
+    }
+    for (const char *fileName : MUSIC_FILES) {
+        jobs.push_back({AssetGroup::MATCH, AssetKind::MUSIC, fileName, {{}, nullptr}, nullptr, nullptr, 0});
+    }
+    for (const char *fileName : EFFECT_FILES) {
+        jobs.push_back({AssetGroup::MATCH, AssetKind::EFFECT, fileName, {{}, nullptr}, nullptr, nullptr, 0});
+    }
+
+    for (const auto& job : jobs) {
+        ++pending[static_cast<int>(job.group)];
+    }
+
+    const int threads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()) - 1);
+    for (int i = 0; i < threads; ++i) {
+        workers.emplace_back(&AssetLoader::work, this);
+    }
+    logv("Loading %zu assets on %d threads\n", jobs.size(), threads);
+}
+
+void AssetLoader::work() {
+    for (;;) {
+        Job job;
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            if (jobs.empty()) {
+                return;
+            }
+            job = std::move(jobs.front());
+            jobs.pop_front();
+        }
+
+        const auto begin = std::chrono::steady_clock::now();
+        switch (job.kind) {
+            case AssetKind::IMAGE:
+                if ((job.image.surface = archive.surface(job.path)) == nullptr) {
+                    job.image.surface = Renderer::loadSurface(job.path);
+                }
+                break;
+            case AssetKind::EFFECT:
+                if ((job.effect = archive.chunk(job.path)) == nullptr
+                        && (job.effect = Mix_LoadWAV(job.path.c_str())) == nullptr) {
+                    logv("Failed to load sound: %s\n SDL_mixer Error: %s\n", job.path.c_str(), Mix_GetError());
+                }
+                break;
+            case AssetKind::MUSIC:
+                if ((job.music = Mix_LoadMUS(job.path.c_str())) == nullptr) {
+                    logv("Failed to load music: %s\n SDL_mixer Error: %s\n", job.path.c_str(), Mix_GetError());
+                }
+                break;
+        }
+        job.decodeMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            done.push_back(std::move(job));
+        }
+        finished.notify_one();
+    }
+}
+
+/**
+ * Hands finished sounds to the AudioManager and keeps finished images until their whole group
+ * is decoded, then packs the group into its own atlas pages in one go.
+ */
+void AssetLoader::pump() {
+    std::vector<Job> finishedJobs;
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        finishedJobs.swap(done);
+    }
+
+    for (auto& job : finishedJobs) {
+        const int group = static_cast<int>(job.group);
+        decodeMs += job.decodeMs;
+
+        switch (job.kind) {
+            case AssetKind::IMAGE:
+                decoded[group].push_back(job.image);
+                break;
+            case AssetKind::EFFECT:
+                AudioManager::instance().addEffect(job.path.c_str(), job.effect);
+                break;
+            case AssetKind::MUSIC:
+                AudioManager::instance().addMusic(job.path.c_str(), job.music);
+                break;
+        }
+
+        if (--pending[group] == 0) {
+            Renderer::createAtlas(decoded[group]);
+            decoded[group].clear();
+            logv("%s assets ready %.1fms after start, %.1fms spent decoding\n",
+                job.group == AssetGroup::MENU ? "Menu" : "Match",
+                std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - started).count(),
+                decodeMs);
+        }
+    }
+}
+
+void AssetLoader::wait(const AssetGroup group) {
+    while (!ready(group)) {
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            finished.wait(guard, [this]{return !done.empty();});
+        }
+        pump();
+    }
+}
+
+void AssetLoader::stop() {
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        jobs.clear();
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    workers.clear();
+
+    // anything decoded but never uploaded
+    for (auto& job : done) {
+        SDL_FreeSurface(job.image.surface);
+        if (job.effect != nullptr) {
+            Mix_FreeChunk(job.effect);
+        }
+        if (job.music != nullptr) {
+            Mix_FreeMusic(job.music);
+        }
+    }
+    done.clear();
+    for (auto& group : decoded) {
+        for (auto& image : group) {
+            SDL_FreeSurface(image.surface);
+        }
+        group.clear();
+    }
+}
@@ -0,0 +1,82 @@
+#ifndef ASSETLOADER_H
+#define ASSETLOADER_H
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_mixer.h>
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../sprites/Renderer.h"
+#include "../archive/AssetArchive.h"
+
+// assets are grouped by the first state that needs them, in load order
+enum class AssetGroup : int {
+    MENU,
+    MATCH
+};
+
+static constexpr int ASSET_GROUPS = 2;
+
+/*
+ * Decodes the game's images and sounds on worker threads at startup.
+ * Images and effects found in the packed ASSET_ARCHIVE are used straight from its mapping,
+ * already decoded, the others are decoded from their loose file.
+ * Workers only do CPU work: IMG_Load into an ARGB surface, Mix_LoadWAV and Mix_LoadMUS.
+ * Everything touching the renderer happens in pump(), called from the render thread,
+ * which packs a group's images into its atlas once they are all decoded and hands
+ * the sounds to the AudioManager. The menu group is queued first so the menu can be
+ * shown while the match assets are still loading.
+ */
+class AssetLoader {
+public:
+    static AssetLoader& instance();
+
+    void start(); // queues every asset and starts the workers
+    void pump(); // uploads what the workers finished, render thread only
+    void wait(const AssetGroup group); // pumps until the group is loaded
+    void stop(); // waits for the workers, discarding what was not uploaded
+
+    bool ready(const AssetGroup group) const {return pending[static_cast<int>(group)] == 0;}
+
+private:
+    AssetLoader() = default;
+    ~AssetLoader();
+
+    enum class AssetKind {IMAGE, EFFECT, MUSIC};
+
+    struct Job {
+        AssetGroup group;
+        AssetKind kind;
+        std::string path;
+        AtlasImage image; // ids of an IMAGE, the surface is filled in by the worker
+        Mix_Chunk *effect;
+        Mix_Music *music;
+        double decodeMs; // time the worker spent on it
+    };
+
+    void work();
+
+    static AssetLoader sInstance;
+
+    AssetArchive archive; // stays mapped, quick loaded effects play from it
+
+    std::vector<std::thread> workers;
+    std::mutex lock;
+    std::condition_variable finished; // signalled whenever a job lands in done
+    std::deque<Job> jobs;
+    std::vector<Job> done;
+
+    // only touched by the render thread
+    std::array<int, ASSET_GROUPS> pending{};
+    std::array<std::vector<AtlasImage>, ASSET_GROUPS> decoded; // images waiting for the rest of their group
+    std::chrono::steady_clock::time_point started;
+    double decodeMs = 0; // decode time summed over all workers
+};
+
+#endif
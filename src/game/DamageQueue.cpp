@@ -0,0 +1,67 @@
+#include <algorithm>
+#include <array>
+#include <omp.h>
+
+#include "DamageQueue.h"
+
+DamageQueue::DamageQueue() : buffers(omp_get_max_threads()) {
+
+}
+
+void DamageQueue::push(const int32_t id, const int damage) {
+    buffers[omp_get_thread_num()].push_back({id, damage});
+}
+
+bool DamageQueue::empty() const {
+    for (const auto& buffer : buffers) {
+        if (!buffer.empty()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Sorting by id puts every hit on the same entity next to each other,
+ * they are then summed so each entity is only looked up and damaged once.
+ * Ids are non negative so they are radix sorted a byte at a time, skipping the bytes
+ * every id shares, which with the ids handed out by GameManager is usually the top two.
+ */
+const std::vector<DamageEvent>& DamageQueue::drain() {
+    merged.clear();
+    for (auto& buffer : buffers) {
+        merged.insert(merged.end(), buffer.begin(), buffer.end());
+        buffer.clear();
+    }
+
+    scratch.resize(merged.size());
+    for (int shift = 0; shift < 32; shift += 8) {
+        std::array<size_t, 257> offsets{};
+        for (const auto& event : merged) {
+            ++offsets[((event.id >> shift) & 0xFF) + 1];
+        }
+        if (std::find(offsets.begin(), offsets.end(), merged.size()) != offsets.end()) {
+            continue; // every id has the same byte here
+        }
+        for (size_t i = 1; i < offsets.size(); ++i) {
+            offsets[i] += offsets[i - 1];
+        }
+        for (const auto& event : merged) {
+            scratch[offsets[(event.id >> shift) & 0xFF]++] = event;
+        }
+        merged.swap(scratch);
+    }
+
+    size_t last = 0;
+    for (size_t i = 1; i < merged.size(); ++i) {
+        if (merged[i].id == merged[last].id) {
+            merged[last].damage += merged[i].damage;
+        } else {
+            merged[++last] = merged[i];
+        }
+    }
+    if (!merged.empty()) {
+        merged.resize(last + 1);
+    }
+    return merged;
+}
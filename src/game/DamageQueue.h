@@ -0,0 +1,34 @@
+#ifndef DAMAGEQUEUE_H
+#define DAMAGEQUEUE_H
+
+#include <cstdint>
+#include <vector>
+
+// damage dealt to the entity with the given id
+struct DamageEvent {
+    int32_t id;
+    int damage;
+};
+
+/*
+ * Collects hits while weapons, projectiles and turrets are updated so no entity is changed
+ * in the middle of an update. Every OpenMP thread appends to its own buffer, so hits can be
+ * pushed from parallel loops without locking. drain hands back all of them at once, merged
+ * and totalled per entity, for GameManager::applyDamage.
+ */
+class DamageQueue {
+public:
+    DamageQueue();
+    ~DamageQueue() = default;
+
+    void push(const int32_t id, const int damage); // records a hit from the calling thread
+    const std::vector<DamageEvent>& drain(); // merges every buffer into one event per id, sorted by id
+    bool empty() const;
+
+private:
+    std::vector<std::vector<DamageEvent>> buffers; // one per thread
+    std::vector<DamageEvent> merged;
+    std::vector<DamageEvent> scratch; // second buffer for the radix sort
+};
+
+#endif
@@ -0,0 +1,17 @@
+#include "FrameExchange.h"
+
+/**
+ * Release ordering publishes everything written into the packet along with its index, and
+ * the acquire side of the exchange hands back a packet the render thread is done with.
+ */
+void FrameExchange::publish() {
+    writing = middle.exchange(writing | FRESH, std::memory_order_acq_rel) & INDEX;
+}
+
+FramePacket * FrameExchange::acquire() {
+    if ((middle.load(std::memory_order_acquire) & FRESH) == 0) {
+        return nullptr;
+    }
+    reading = middle.exchange(reading, std::memory_order_acq_rel) & INDEX;
+    return &packets[reading];
+}
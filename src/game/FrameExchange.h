@@ -0,0 +1,64 @@
+#ifndef FRAMEEXCHANGE_H
+#define FRAMEEXCHANGE_H
+
+#include <SDL2/SDL.h>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include "../sprites/RenderQueue.h"
+
+static constexpr int FRAME_PACKETS = 3;
+
+// values the hud shows, copied out of the match so the render thread never reads it
+struct HudValues {
+    float ticksPerSecond;
+    int health;
+    int clip;
+    int ammo;
+    bool armed; // false when the marine holds no weapon
+};
+
+/*
+ * Everything the render thread needs to draw one simulation tick, filled in by the simulation.
+ * The sprites are already culled to view and positioned relative to it.
+ */
+struct FramePacket {
+    uint64_t tick;
+    SDL_Rect view; // camera viewport in map coordinates
+    RenderQueue sprites;
+    std::vector<SDL_Rect> walls; // baked into the background when mapVersion changes
+    int mapVersion;
+    HudValues hud;
+};
+
+/*
+ * Triple buffered hand-off of frame packets from the simulation thread to the render thread.
+ * The simulation always owns one packet to fill and the render thread one to draw, the third
+ * holds the latest published tick. Publishing and acquiring swap a packet with that middle one
+ * through a single atomic exchange, so neither side ever waits for the other: a slow present
+ * only means the render thread skips to the newest tick, and a fast render thread draws a tick
+ * at most once.
+ */
+class FrameExchange {
+public:
+    FrameExchange() = default;
+    ~FrameExchange() = default;
+
+    FramePacket& back() {return packets[writing];} // the packet the simulation fills, simulation thread only
+    void publish(); // makes back() the latest tick and hands the simulation another packet
+
+    FramePacket * acquire(); // the latest tick if one was published since the last call, nullptr otherwise
+
+private:
+    static constexpr int FRESH = 1 << 2; // set on the middle index when it holds a tick not yet acquired
+    static constexpr int INDEX = FRESH - 1;
+
+    std::array<FramePacket, FRAME_PACKETS> packets{};
+    int writing = 0; // owned by the simulation thread
+    int reading = 1; // owned by the render thread
+    std::atomic<int> middle{2};
+};
+
+#endif
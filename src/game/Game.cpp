@@ -7,6 +7,8 @@
 #include <string>
 
 #include "../game/Game.h"
+#include "../game/AssetLoader.h"
+#include "../audio/AudioManager.h"
 #include "../game/GameStateMatch.h"
 #include "../game/GameStateMenu.h"
 #include "../view/Window.h"
@@ -97,7 +99,7 @@ bool Game::init() {
                 }
 
                 //Initialize SDL_mixer
-                if (Mix_OpenAudio(44100, MIX_DEFAULT_FORMAT, 2, 2048) < 0) {
+                if (Mix_OpenAudio(AUDIO_FREQUENCY, MIX_DEFAULT_FORMAT, AUDIO_CHANNELS, AUDIO_CHUNK_SIZE) < 0) {
                     logv("SDL_mixer could not initialize! SDL_mixer Error: %s\n", Mix_GetError());
                     success = false;
                 }
@@ -107,8 +109,10 @@ bool Game::init() {
     return success;
 }
 
+// Starts decoding every asset in the background and returns once the menu's are uploaded
 bool Game::loadMedia() {
-    Renderer::instance()->loadSprites();
+    AssetLoader::instance().start();
+    AssetLoader::instance().wait(AssetGroup::MENU);
     return true;
 }
 
@@ -118,6 +122,9 @@ void Game::close() {
         delete state;
     }
 
+    //Stop loading before the subsystems the workers use go away
+    AssetLoader::instance().stop();
+
     //Destroy window
     window.free();
 
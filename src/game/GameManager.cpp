@@ -1,6 +1,7 @@
 #include <memory>
 #include <utility>
 #include <atomic>
+#include <algorithm>
 
 #include "../collision/HitBox.h"
 #include "../log/log.h"
@@ -20,7 +21,7 @@ int32_t GameManager::generateID() {
     return ++counter;
 }
 
-GameManager::GameManager():collisionHandler() {
+GameManager::GameManager():collisionHandler(), zombieGrid({0, 0, MAP_WIDTH, MAP_HEIGHT}) {
     logv("Create GM\n");
 }
 
@@ -28,71 +29,162 @@ GameManager::~GameManager() {
     logv("Destroy GM\n");
 }
 
-// Render all objects in level
-void GameManager::renderObjects(const SDL_Rect& cam) {
-    const int camX = cam.x;
-    const int camY = cam.y;
-    const int camW = cam.w;
-    const int camH = cam.h;
-
-    for (const auto& m : weaponDropManager) {
-        if (m.second.getX() - camX < camW) {
-            if (m.second.getY() - camY < camH) {
-                Renderer::instance()->render(m.second.getRelativeDestRect(cam), TEXTURES::CONCRETE);
+// true when the sprite at dest overlaps the camera, both in map coordinates
+static bool inView(const SDL_Rect& dest, const SDL_Rect& cam) {
+    return dest.x < cam.x + cam.w && dest.x + dest.w > cam.x && dest.y < cam.y + cam.h && dest.y + dest.h > cam.y;
+}
+
+/**
+ * Queue all objects in level for rendering.
+ * Zombies and map objects are looked up through their quadtree with the camera
+ * rect grown by CULL_MARGIN, since the trees were filled at the start of the tick and file
+ * entities by movement hitbox rather than sprite. Every candidate is then tested against the
+ * camera with its dest rect, so nothing off screen on any side reaches the queue.
+ */
+void GameManager::renderObjects(const SDL_Rect& cam, RenderQueue& queue) {
+    renderStats = {0, 0, 0};
+
+    // animated entities draw their current clip from the sheet of their animation
+    const auto submit = [&](const Entity& e, const RenderLayer layer, const TEXTURES texture, const double angle) {
+        if (inView(e.getDestRect(), cam)) {
+            const uint16_t animation = e.getAnimation();
+            if (animation == NO_ANIMATION) {
+                queue.push(layer, texture, e.getRelativeDestRect(cam), angle);
+            } else {
+                const SDL_Rect& clip = Animations::clip(animation, e.getId());
+                queue.push(layer, Animations::texture(animation),
+                    Animations::place(animation, e.getRelativeDestRect(cam), clip), clip, angle);
             }
+            ++renderStats.submitted;
         }
-    }
-
-    for (const auto& m : marineManager) {
-        if (m.second.getX() - camX < camW) {
-            if (m.second.getY() - camY < camH) {
-                Renderer::instance()->render(m.second.getRelativeDestRect(cam), TEXTURES::MARINE,
-                    m.second.getAngle());
-            }
+    };
+
+    // queues the visible entities filed in a quadtree, for the managers that can grow large
+    const auto submitVisible = [&](const Quadtree& tree, const RenderLayer layer, const TEXTURES texture) {
+        visibleEntities.clear();
+        tree.retrieve({cam.x - CULL_MARGIN, cam.y - CULL_MARGIN, cam.w + 2 * CULL_MARGIN, cam.h + 2 * CULL_MARGIN},
+            visibleEntities);
+        for (const Entity *e : visibleEntities) {
+            submit(*e, layer, texture, 0.0);
         }
-    }
+    };
 
+    // queues the visible entities of a small manager by testing each one
+    const auto submitEach = [&](const auto& manager, const RenderLayer layer, const TEXTURES texture) {
+        for (const auto& e : manager) {
+            submit(e.second, layer, texture, 0.0);
+        }
+    };
 
-    for (const auto& o : objectManager) {
-        if (o.second.getX() - camX < camW) {
-            if (o.second.getY() - camY < camH) {
-                Renderer::instance()->render(o.second.getRelativeDestRect(cam), TEXTURES::CONCRETE);
-            }
+    submitEach(weaponDropManager, RenderLayer::OBJECTS, TEXTURES::CONCRETE);
+    for (const auto& m : marineManager) {
+        submit(m.second, RenderLayer::MARINES, TEXTURES::MARINE, m.second.getAngle());
+    }
+    submitVisible(collisionHandler.quadtreeObj, RenderLayer::OBJECTS, TEXTURES::CONCRETE);
+    // turrets and barricades are only in their quadtrees once placed, carried ones still have to be drawn
+    for (const auto& t : turretManager) {
+        submit(t.second, RenderLayer::TURRETS, TEXTURES::CONCRETE, t.second.getAngle());
+    }
+    submitEach(barricadeManager, RenderLayer::OBJECTS, TEXTURES::CONCRETE);
+    // walls are static and drawn by the match's baked background
+
+    for (const auto& p : projectilePool.getProjectiles()) {
+        const SDL_Rect dest = {static_cast<int>(p.x) - PROJECTILE_SIZE / 2,
+            static_cast<int>(p.y) - PROJECTILE_SIZE / 2, PROJECTILE_SIZE, PROJECTILE_SIZE};
+        if (inView(dest, cam)) {
+            queue.push(RenderLayer::PROJECTILES, TEXTURES::CONCRETE, {dest.x - cam.x, dest.y - cam.y, dest.w, dest.h});
+            ++renderStats.submitted;
         }
     }
 
-    for (const auto& z : zombieManager) {
-        if (z.second.getX() - camX < camW) {
-            if (z.second.getY() - camY < camH) {
-                Renderer::instance()->render(z.second.getRelativeDestRect(cam), TEXTURES::BABY_ZOMBIE);
-            }
+    // corpses are out of the zombie quadtree, there are only ever a few of them
+    for (const auto& c : corpses) {
+        const auto z = zombieManager.find(c.id);
+        if (z != zombieManager.end()) {
+            submit(z->second, RenderLayer::CREEPS, TEXTURES::BABY_ZOMBIE, 0.0);
         }
     }
 
-    for (const auto& m : turretManager) {
-        if (m.second.getX() - camX < camW) {
-            if (m.second.getY() - camY < camH) {
-                Renderer::instance()->render(m.second.getRelativeDestRect(cam), TEXTURES::CONCRETE,
-                    m.second.getAngle());
-            }
-        }
+    // last, so they get whatever is left of the budget
+    const int merged = renderZombies(cam, queue);
+
+    renderStats.culled = weaponDropManager.size() + marineManager.size() + objectManager.size() + zombieManager.size()
+        + turretManager.size() + barricadeManager.size() + projectilePool.size()
+        - renderStats.submitted - merged;
+}
+
+/**
+ * Queues the zombies in view. Past lodDensity of them, or once the budget runs out, only the
+ * ones nearest the camera centre are drawn in full. Each of the others is drawn as an impostor,
+ * its sheet's still front facing frame, if no other impostor is in its LOD_CELL_SIZE screen
+ * cell yet, and is merged into that one otherwise, so a packed horde costs one sprite per cell.
+ * Impostors may exceed the budget by up to one sprite per cell on screen.
+ * Returns the zombies in view merged into another's impostor, they are neither queued nor culled.
+ */
+int GameManager::renderZombies(const SDL_Rect& cam, RenderQueue& queue) {
+    visibleEntities.clear();
+    collisionHandler.quadtreeZombie.retrieve({cam.x - CULL_MARGIN, cam.y - CULL_MARGIN, cam.w + 2 * CULL_MARGIN,
+        cam.h + 2 * CULL_MARGIN}, visibleEntities);
+    visibleEntities.erase(std::remove_if(visibleEntities.begin(), visibleEntities.end(),
+        [&](const Entity *e) {return !inView(e->getDestRect(), cam);}), visibleEntities.end());
+
+    const size_t budget = std::max(0, renderBudget - renderStats.submitted);
+    const size_t detailed = std::min({visibleEntities.size(), budget, static_cast<size_t>(std::max(0, lodDensity))});
+
+    if (detailed < visibleEntities.size()) {
+        const int centreX = cam.x + cam.w / 2;
+        const int centreY = cam.y + cam.h / 2;
+        const auto distance = [&](const Entity *e) {
+            const SDL_Rect& d = e->getDestRect();
+            const int dx = d.x + d.w / 2 - centreX;
+            const int dy = d.y + d.h / 2 - centreY;
+            return dx * dx + dy * dy;
+        };
+        std::nth_element(visibleEntities.begin(), visibleEntities.begin() + detailed, visibleEntities.end(),
+            [&](const Entity *a, const Entity *b) {return distance(a) < distance(b);});
     }
 
-    for (const auto& b : barricadeManager) {
-        if (b.second.getX() - camX < camW) {
-            if (b.second.getY() - camY < camH) {
-                Renderer::instance()->render(b.second.getRelativeDestRect(cam), TEXTURES::CONCRETE);
-            }
+    for (size_t i = 0; i < detailed; ++i) {
+        const Entity& e = *visibleEntities[i];
+        const uint16_t animation = e.getAnimation();
+        if (animation == NO_ANIMATION) {
+            queue.push(RenderLayer::CREEPS, TEXTURES::BABY_ZOMBIE, e.getRelativeDestRect(cam));
+        } else {
+            const SDL_Rect& clip = Animations::clip(animation, e.getId());
+            queue.push(RenderLayer::CREEPS, Animations::texture(animation),
+                Animations::place(animation, e.getRelativeDestRect(cam), clip), clip);
         }
     }
-
-    for (const auto& w : wallManager) {
-        if (w.second.getX() - camX < camW) {
-            if (w.second.getY() - camY < camH) {
-                Renderer::instance()->render(w.second.getRelativeDestRect(cam), TEXTURES::CONCRETE);
-            }
+    renderStats.submitted += detailed;
+
+    const int columns = cam.w / LOD_CELL_SIZE + 1;
+    const int rows = cam.h / LOD_CELL_SIZE + 1;
+    impostorCells.assign(columns * rows, false);
+    int merged = 0;
+
+    for (size_t i = detailed; i < visibleEntities.size(); ++i) {
+        const Entity& e = *visibleEntities[i];
+        const SDL_Rect dest = e.getRelativeDestRect(cam);
+        const int column = std::min(std::max((dest.x + dest.w / 2) / LOD_CELL_SIZE, 0), columns - 1);
+        const int row = std::min(std::max((dest.y + dest.h / 2) / LOD_CELL_SIZE, 0), rows - 1);
+
+        if (impostorCells[row * columns + column]) {
+            ++merged;
+            continue;
+        }
+        impostorCells[row * columns + column] = true;
+
+        const uint16_t animation = e.getAnimation();
+        if (animation == NO_ANIMATION) {
+            queue.push(RenderLayer::CREEPS, TEXTURES::BABY_ZOMBIE, dest);
+        } else {
+            const uint16_t still = Animations::select(animation, AnimationAction::IDLE, SheetRow::FRONT);
+            queue.push(RenderLayer::CREEPS, Animations::texture(still), dest, Animations::clip(still, 0));
         }
+        ++renderStats.submitted;
     }
+    renderStats.degraded = visibleEntities.size() - detailed;
+    return merged;
 }
 
 // Update marine movements. health, and actions
@@ -105,6 +197,9 @@ void GameManager::updateMarines(const float delta) {
 // Update zombie movements.
 void GameManager::updateZombies(const float delta) {
     for (auto& z : zombieManager) {
+        if (z.second.getState() == ZombieState::ZOMBIE_DIE) {
+            continue;
+        }
         z.second.generateMove();
         if (z.second.isMoving()) {
             z.second.move((z.second.getDX() * delta), (z.second.getDY() * delta), collisionHandler);
@@ -114,12 +209,250 @@ void GameManager::updateZombies(const float delta) {
 
 // Update turret actions.
 // Jamie, 2017-03-01.
+/**
+ * Turrets that still have a live target in range just keep tracking it. The ones that lost
+ * theirs and are due for a scan are grouped into clusters of overlapping range rects, and each
+ * cluster is packed together with every zombie in its bounding box so nearestTargets finds all
+ * its turrets' closest targets in one batched pass. Turrets far apart never share a query, and
+ * a cluster strung out so far its bounding box is mostly empty, like turrets ringing the base,
+ * falls back to a query per turret.
+ */
 void GameManager::updateTurrets(const float delta) {
+    const int currentTime = SDL_GetTicks();
+
+    scanningTurrets.clear();
+    turretClusters.clear();
+    clusterAreas.clear();
+
     for (auto& t : turretManager) {
-        t.second.targetScanTurret();
+        Turret& turret = t.second;
+        if (turret.trackTarget() || !turret.scanDue(currentTime)) {
+            continue;
+        }
+
+        // joins every cluster its range overlaps, merging them when there are several
+        const SDL_Rect rangeRect = turret.getRangeRect();
+        int joined = -1;
+        for (size_t c = 0; c < clusterAreas.size(); ++c) {
+            if (SDL_RectEmpty(&clusterAreas[c]) || !SDL_HasIntersection(&clusterAreas[c], &rangeRect)) {
+                continue;
+            }
+            if (joined < 0) {
+                joined = c;
+                SDL_UnionRect(&clusterAreas[c], &rangeRect, &clusterAreas[c]);
+                continue;
+            }
+            SDL_UnionRect(&clusterAreas[joined], &clusterAreas[c], &clusterAreas[joined]);
+            clusterAreas[c] = {0, 0, 0, 0};
+            for (auto& cluster : turretClusters) {
+                if (cluster == static_cast<int>(c)) {
+                    cluster = joined;
+                }
+            }
+        }
+        if (joined < 0) {
+            joined = clusterAreas.size();
+            clusterAreas.push_back(rangeRect);
+        }
+
+        scanningTurrets.push_back(&turret);
+        turretClusters.push_back(joined);
+    }
+
+    for (size_t c = 0; c < clusterAreas.size(); ++c) {
+        const SDL_Rect& area = clusterAreas[c];
+        if (SDL_RectEmpty(&area)) {
+            continue;
+        }
+
+        clusterTurrets.clear();
+        long cover = 0;
+        for (size_t i = 0; i < scanningTurrets.size(); ++i) {
+            if (turretClusters[i] == static_cast<int>(c)) {
+                const SDL_Rect rangeRect = scanningTurrets[i]->getRangeRect();
+                cover += static_cast<long>(rangeRect.w) * rangeRect.h;
+                clusterTurrets.push_back(scanningTurrets[i]);
+            }
+        }
+
+        if (static_cast<long>(area.w) * area.h <= cover * TURRET_CLUSTER_SPARSITY) {
+            acquireTargets(area, clusterTurrets);
+            continue;
+        }
+        for (auto& turret : clusterTurrets) {
+            const std::vector<Turret *> single = {turret};
+            acquireTargets(turret->getRangeRect(), single);
+        }
+    }
+}
+
+// finds the closest zombie in range for every turret among the zombies in area, which covers their ranges
+void GameManager::acquireTargets(const SDL_Rect& area, const std::vector<Turret *>& turrets) {
+    turretPack.clear();
+    for (const auto turret : turrets) {
+        turretPack.push(turret->getX() + TURRET_WIDTH / 2, turret->getY() + TURRET_HEIGHT / 2, turret->getRange());
+    }
+
+    const std::vector<Entity *> candidates = collisionHandler.quadtreeZombie.retrieve(area);
+    zombiePack.clear();
+    for (const auto zombie : candidates) {
+        zombiePack.push(zombie->getX() + ZOMBIE_WIDTH / 2, zombie->getY() + ZOMBIE_HEIGHT / 2, zombie->getId());
+    }
+
+    nearestTargets(turretPack, zombiePack, nearestZombies);
+    for (size_t i = 0; i < turrets.size(); ++i) {
+        if (nearestZombies[i] >= 0) {
+            turrets[i]->setTarget(*candidates[nearestZombies[i]]);
+        }
+    }
+}
+
+
+/**
+ * Move projectiles in flight and resolve what they hit.
+ * Zombies are filed into a grid for this, thousands of projectiles each asking for the few
+ * zombies around them is cheaper there than in the quadtree.
+ */
+void GameManager::updateProjectiles(const float delta) {
+    if (projectilePool.size() == 0) {
+        return;
+    }
+
+    zombieGrid.clear();
+    for (auto& z : zombieManager) {
+        if (z.second.getState() != ZombieState::ZOMBIE_DIE) {
+            zombieGrid.insert(&z.second);
+        }
     }
+    projectilePool.update(delta, zombieGrid, collisionHandler.quadtreeWall, damageQueue);
 }
 
+/**
+ * Applies every hit queued this tick, one lookup per damaged entity.
+ * Ids are shared between the managers so each one is tried in turn, ids that are not
+ * found, like walls, take no damage. Whatever dies is left for despawnDead.
+ */
+void GameManager::applyDamage() {
+    if (damageQueue.empty()) {
+        return;
+    }
+
+    for (const auto& event : damageQueue.drain()) {
+        const auto z = zombieManager.find(event.id);
+        if (z != zombieManager.end()) {
+            if (z->second.getState() != ZombieState::ZOMBIE_DIE) {
+                z->second.collidingProjectile(event.damage);
+                if (z->second.getHealth() <= 0) {
+                    z->second.die();
+                    deadZombies.push_back(event.id);
+                }
+            }
+            continue;
+        }
+
+        const auto m = marineManager.find(event.id);
+        if (m != marineManager.end()) {
+            m->second.collidingProjectile(event.damage);
+            if (m->second.getHealth() <= 0) {
+                logv("Marine %d died\n", event.id);
+            }
+            continue;
+        }
+
+        const auto t = turretManager.find(event.id);
+        if (t != turretManager.end()) {
+            t->second.collidingProjectile(event.damage);
+            if (!t->second.healthCheckTurret()) {
+                deadTurrets.push_back(event.id);
+            }
+            continue;
+        }
+
+        const auto b = barricadeManager.find(event.id);
+        if (b != barricadeManager.end()) {
+            b->second.collidingProjectile(event.damage);
+            if (b->second.getHealth() <= 0) {
+                deadBarricades.push_back(event.id);
+            }
+        }
+    }
+
+}
+
+/**
+ * End of tick cleanup. Everything that died this tick is taken out of the quadtrees in one
+ * pass per tree, so queries made before the next updateCollider (eg. shots fired while
+ * handling input) never see it, then erased from its manager, freeing its storage for the
+ * next spawn. Dead zombies are the exception, their corpses stay in the zombie manager,
+ * outside every tree, until their death clip has played for ZOMBIE_DEATH_MS. The zombie
+ * count, and with it memory and tick time, only grows with the zombies alive or just killed.
+ */
+void GameManager::despawnDead(const float delta) {
+    size_t expired = 0;
+    for (auto& corpse : corpses) {
+        corpse.remaining -= delta;
+        if (corpse.remaining <= 0) {
+            deleteZombie(corpse.id);
+            ++expired;
+        }
+    }
+    if (expired > 0) {
+        corpses.erase(std::remove_if(corpses.begin(), corpses.end(), [](const Corpse& c) {return c.remaining <= 0;}),
+            corpses.end());
+    }
+
+    if (deadZombies.empty() && deadTurrets.empty() && deadBarricades.empty()) {
+        return;
+    }
+
+    deadEntities.clear();
+    for (const auto id : deadZombies) {
+        const auto it = zombieManager.find(id);
+        if (it != zombieManager.end()) {
+            deadEntities.push_back(&it->second);
+        }
+    }
+    std::sort(deadEntities.begin(), deadEntities.end());
+    collisionHandler.quadtreeZombie.remove(deadEntities);
+
+    deadEntities.clear();
+    for (const auto id : deadTurrets) {
+        const auto it = turretManager.find(id);
+        if (it != turretManager.end()) {
+            deadEntities.push_back(&it->second);
+        }
+    }
+    std::sort(deadEntities.begin(), deadEntities.end());
+    collisionHandler.quadtreeTurret.remove(deadEntities);
+    collisionHandler.quadtreePickUp.remove(deadEntities);
+
+    deadEntities.clear();
+    for (const auto id : deadBarricades) {
+        const auto it = barricadeManager.find(id);
+        if (it != barricadeManager.end()) {
+            deadEntities.push_back(&it->second);
+        }
+    }
+    std::sort(deadEntities.begin(), deadEntities.end());
+    collisionHandler.quadtreeBarricade.remove(deadEntities);
+
+    for (const auto id : deadZombies) {
+        corpses.push_back({id, ZOMBIE_DEATH_MS / 1000.0f});
+    }
+    for (const auto id : deadTurrets) {
+        deleteTurret(id);
+    }
+    for (const auto id : deadBarricades) {
+        deleteBarricade(id);
+    }
+
+    logv("Killed %zu zombies, despawned %zu turrets, %zu barricades\n", deadZombies.size(), deadTurrets.size(),
+        deadBarricades.size());
+
+    deadZombies.clear();
+    deadTurrets.clear();
+    deadBarricades.clear();
+}
 
 // Create marine add it to manager, returns marine id
 int32_t GameManager::createMarine() {
@@ -232,7 +565,7 @@ int32_t GameManager::addZombie(const Zombie& newZombie) {
 // Create zombie add it to manager, returns success
 bool GameManager::createZombie(const float x, const float y) {
     const int32_t id = generateID();
-    SDL_Rect temp = {initVal, initVal, defaultSize, defaultSize};
+    SDL_Rect temp = {initVal, initVal, ZOMBIE_WIDTH, ZOMBIE_HEIGHT}; // one cell of its sheet
 
     SDL_Rect zombieRect = temp;
     SDL_Rect moveRect = temp;
@@ -288,17 +621,21 @@ int32_t GameManager::addWeaponDrop(WeaponDrop& newWeaponDrop) {
 
 
 
-// Create weapon drop add it to manager, returns success
+// Create rifle drop add it to manager, returns success
 bool GameManager::createWeaponDrop(const float x, const float y) {
+    return createWeaponDrop(x, y, std::make_shared<Rifle>());
+}
 
-    Rifle w;
-    const int32_t wid = w.getId();
+// Create a drop holding weapon, adds both to their managers, returns the drop's id
+int32_t GameManager::createWeaponDrop(const float x, const float y, std::shared_ptr<Weapon> weapon) {
+
+    const int32_t wid = weapon->getId();
     const int32_t id = generateID();
 
     SDL_Rect weaponDropRect = {static_cast<int>(x),static_cast<int>(y),defaultSize, defaultSize};
     SDL_Rect pickRect = {static_cast<int>(x),static_cast<int>(y),defaultSize, defaultSize};
 
-    addWeapon(std::dynamic_pointer_cast<Weapon>(std::make_shared<Rifle>(w)));
+    addWeapon(weapon);
 
     WeaponDrop wd(id, weaponDropRect, pickRect, wid);
     weaponDropManager.insert({id, wd});
@@ -348,7 +685,9 @@ void GameManager::updateCollider() {
     }
 
     for (auto& z : zombieManager) {
-        collisionHandler.quadtreeZombie.insert(&z.second);
+        if (z.second.getState() != ZombieState::ZOMBIE_DIE) {
+            collisionHandler.quadtreeZombie.insert(&z.second);
+        }
     }
 
     for (auto& o : objectManager) {
@@ -412,6 +751,7 @@ int32_t GameManager::createWall(const float x, const float y, const int w, const
     SDL_Rect pickRect = {static_cast<int>(x), static_cast<int>(y), w, h};
 
     wallManager.insert({id, Wall(id, wallRect, moveRect, pickRect, h, h)});
+    ++mapVersion;
     return id;
 }
 
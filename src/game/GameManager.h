@@ -10,12 +10,16 @@
 #include "../creeps/Zombie.h"
 #include "../player/Marine.h"
 #include "../turrets/Turret.h"
+#include "../turrets/TargetKernel.h"
 #include "../collision/CollisionHandler.h"
 #include "../buildings/Object.h"
 #include "../buildings/Base.h"
 #include "../buildings/Wall.h"
 #include "../buildings/Barricade.h"
 #include "../inventory/WeaponDrop.h"
+#include "../projectiles/ProjectilePool.h"
+#include "DamageQueue.h"
+#include "../sprites/RenderQueue.h"
 
 
 //just for tesing weapon drop
@@ -23,11 +27,27 @@
 #include "../inventory/weapons/HandGun.h"
 #include "../inventory/weapons/Rifle.h"
 #include "../inventory/weapons/ShotGun.h"
+#include "../inventory/weapons/RocketLauncher.h"
 
 constexpr int initVal = 0;
 constexpr int defaultSize = 100;
 constexpr int PUSize = 120;
 
+// how far past the camera the render quadtree query reaches, covers sprites larger than their
+// movement hitbox and entities that moved after the trees were filled
+constexpr int CULL_MARGIN = 150;
+
+// a cluster of scanning turrets whose bounding box is this many times the area of their ranges
+// is spread too thin for one quadtree query, each of its turrets queries its own range instead
+constexpr int TURRET_CLUSTER_SPARSITY = 4;
+
+// sprites queued per frame before the zombies left over are merged, marines, buildings and projectiles always are
+constexpr int RENDER_BUDGET = 2000;
+// zombies in view drawn in full, the rest are drawn as impostors
+constexpr int LOD_DENSITY = 500;
+// screen cell a single impostor stands in for every zombie of, about a zombie wide
+constexpr int LOD_CELL_SIZE = 64;
+
 
 class GameManager {
 public:
@@ -35,7 +55,10 @@ public:
 
     int32_t generateID();
 
-    void renderObjects(const SDL_Rect& cam); // Render all objects in level
+    void renderObjects(const SDL_Rect& cam, RenderQueue& queue); // Queue all objects in level for rendering
+    const RenderStats& getRenderStats() const {return renderStats;} // sprites queued and culled by the last renderObjects
+    // sprites queued per frame at most and zombies in view drawn in full before the rest are degraded
+    void setRenderBudget(const int budget, const int lodDensity) {renderBudget = budget; this->lodDensity = lodDensity;}
 
     // Methods for creating, getting, and deleting marines from the level.
     int32_t createMarine();
@@ -44,6 +67,7 @@ public:
 
     bool addMarine(const int32_t id, const Marine& newMarine);
     Marine& getMarine(const int32_t id);
+    auto& getMarineManager() const {return marineManager;};
 
     // Methods for creating, getting, and deleting towers from the level.
     int32_t createTurret();
@@ -61,6 +85,15 @@ public:
     void updateMarines(const float delta); // Update marine actions
     void updateZombies(const float delta); // Update zombie actions
     void updateTurrets(const float delta); // Update turret actions
+    void updateProjectiles(const float delta); // Move projectiles and apply their hits
+
+    // returns the projectiles in flight.
+    ProjectilePool& getProjectilePool() {return projectilePool;}
+
+    // returns the queue hits are pushed to, they are applied by applyDamage.
+    DamageQueue& getDamageQueue() {return damageQueue;}
+    void applyDamage(); // Apply this tick's hits and collect the deaths they caused
+    void despawnDead(const float delta); // Remove everything that died this tick and corpses that lay long enough
 
     // returns the list of zombies.
     // Jamie, 2017-03-01.
@@ -78,16 +111,21 @@ public:
 
     int32_t addWeaponDrop(WeaponDrop& newWeaponDrop);
     bool createWeaponDrop(const float x, const float y);
+    int32_t createWeaponDrop(const float x, const float y, std::shared_ptr<Weapon> weapon);
     void deleteWeaponDrop(const int32_t id);
     WeaponDrop& getWeaponDrop(const int32_t id);
+    auto& getWeaponDropManager() const {return weaponDropManager;};
     std::shared_ptr<Weapon> getWeapon(const int32_t id);
     int32_t addWeapon(std::shared_ptr<Weapon> newWeaponDrop);
 
     int32_t createBarricade(const float x, const float y);
     void deleteBarricade(const int32_t id);
     Barricade& getBarricade(const int32_t id);
+    auto& getBarricadeManager() const {return barricadeManager;};
 
     int32_t createWall(const float x, const float y, const int h, const int w); // create Wall object
+    auto& getWallManager() const {return wallManager;};
+    int getMapVersion() const {return mapVersion;} // changes whenever a wall is added
     void setBoundary(const float startX, const float startY, const float endX, const float endY); // place walls for the boundaries
 
 
@@ -106,6 +144,39 @@ private:
     std::map<int32_t, std::shared_ptr<Weapon>> weaponManager;
     std::map<int32_t, Barricade> barricadeManager;
     std::map<int32_t, Wall> wallManager;
+    int mapVersion = 0;
+    ProjectilePool projectilePool;
+    SpatialGrid zombieGrid; // zombies filed for the projectile update
+    DamageQueue damageQueue;
+    // entities killed by applyDamage, removed by despawnDead at the end of the tick
+    std::vector<int32_t> deadZombies;
+    std::vector<int32_t> deadTurrets;
+    std::vector<int32_t> deadBarricades;
+    std::vector<Entity *> deadEntities;
+    // dead zombies left lying outside the collision trees until their death clip has played
+    struct Corpse {
+        int32_t id;
+        float remaining; // seconds
+    };
+    std::vector<Corpse> corpses;
+
+    // scratch space for the batched turret target search, kept to avoid reallocating every frame
+    std::vector<Turret *> scanningTurrets;
+    std::vector<int> turretClusters; // cluster of each scanning turret
+    std::vector<SDL_Rect> clusterAreas; // bounding box of each cluster, empty once merged into another
+    std::vector<Turret *> clusterTurrets; // turrets of the cluster being searched
+    TurretPack turretPack;
+    ZombiePack zombiePack;
+    std::vector<int32_t> nearestZombies;
+
+    RenderStats renderStats;
+    std::vector<Entity *> visibleEntities; // quadtree candidates for the current renderObjects
+    std::vector<bool> impostorCells; // screen cells already holding a zombie impostor
+    int renderBudget = RENDER_BUDGET;
+    int lodDensity = LOD_DENSITY;
+
+    int renderZombies(const SDL_Rect& cam, RenderQueue& queue); // queues the zombies within the budget left
+    void acquireTargets(const SDL_Rect& area, const std::vector<Turret *>& turrets); // one query and kernel call
 
 };
 
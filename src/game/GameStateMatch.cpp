@@ -1,13 +1,14 @@
 #include <stdio.h>
 #include <iostream>
 #include <string>
-#include <sstream>
-#include <iomanip>
+#include <cmath>
+#include <cstring>
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_image.h>
 #include <SDL2/SDL_ttf.h>
 
 #include "../game/GameStateMatch.h"
+#include "../game/AssetLoader.h"
 #include "../sprites/Renderer.h"
 #include "../sprites/SpriteTypes.h"
 #include "../basic/LTimer.h"
@@ -18,9 +19,28 @@ GameStateMatch::GameStateMatch(Game& g,  int gameWidth, int gameHeight) : GameSt
         base(), camera(gameWidth,gameHeight) {
 }
 
+GameStateMatch::~GameStateMatch() {
+    running = false;
+    if (simulation.joinable()) {
+        simulation.join();
+    }
+    hudText.release();
+    if (hudFont != nullptr) {
+        TTF_CloseFont(hudFont);
+    }
+}
+
 bool GameStateMatch::load() {
     bool success = true;
 
+    //finish loading whatever the menu did not have time for
+    AssetLoader::instance().wait(AssetGroup::MATCH);
+
+    //a missing hud font only costs the hud
+    if ((hudFont = Renderer::instance()->loadFont("assets/fonts/SEGUISB.ttf", HUD_FONT_SIZE)) != nullptr) {
+        hudText.load(Renderer::instance()->getRenderer(), hudFont);
+    }
+
     const int32_t playerMarineID = GameManager::instance()->createMarine();
 
     //set the boundary on the map
@@ -35,6 +55,10 @@ bool GameStateMatch::load() {
     //GameManager::instance()->createZombie(100, 100);
 
     GameManager::instance()->addObject(base);
+
+    // the only rocket launcher, picked up with E into slot 2 or 3
+    GameManager::instance()->createWeaponDrop(base.getX() + base.getWidth() + GAP, base.getY(),
+        std::make_shared<RocketLauncher>());
     Point newPoint = base.getSpawnPoint();
 
     //gives the player control of the marine
@@ -44,50 +68,85 @@ bool GameStateMatch::load() {
     return success;
 }
 
+/**
+ * Runs the simulation on its own thread and draws its ticks on this one, which owns the
+ * window and the renderer. Only ticks published since the last frame are drawn, so a
+ * blocking SDL_RenderPresent drops ticks from the screen but never slows the simulation.
+ */
 void GameStateMatch::loop() {
     //The frames per second timer
     LTimer fpsTimer;
 
-    //The frames per second cap timer
+    //Start counting frames per second
+    unsigned long countedFrames = 0;
+    fpsTimer.start();
+
+    running = true;
+    simulation = std::thread(&GameStateMatch::simulate, this);
+
+    // State Loop
+    while (running) {
+        pumpEvents(); // Hand user input to the simulation
+
+        if ((frame = frames.acquire()) == nullptr) {
+            //No new tick yet
+            SDL_Delay(1);
+            continue;
+        }
+
+        //Calculate and correct fps, drawn by renderHud
+        avgFPS = countedFrames / (fpsTimer.getTicks() / TIME_SECOND);
+
+        render();    // Render game state to window
+        ++countedFrames;
+    }
+
+    simulation.join();
+    play = false;
+}
+
+/**
+ * Simulation thread: handles the input queued by the render thread, steps the match and
+ * publishes the tick, capped at SCREEN_FPS ticks per second.
+ */
+void GameStateMatch::simulate() {
+    //The ticks per second timer
+    LTimer tpsTimer;
+
+    //The ticks per second cap timer
     LTimer capTimer;
 
     //Keeps track of time between steps
     LTimer stepTimer;
 
-    //Start counting frames per second
-    unsigned long countedFrames = 0;
+    //Start counting ticks per second
+    unsigned long countedTicks = 0;
     int frameTicks;
     unsigned int second = 0;
-    float avgFPS = 0;
-    fpsTimer.start();
+    tpsTimer.start();
 
-    // State Loop
-    while (play) {
+    while (running) {
         //Start cap timer
         capTimer.start();
 
-        //Calculate and correct fps
-        avgFPS = countedFrames / (fpsTimer.getTicks() / TIME_SECOND);
-
-        //Set FPS text to be rendered
-        frameTimeText.str("");
-        frameTimeText << std::fixed << std::setprecision(0) << "FPS: " << avgFPS;
-
-        // Process frame
+        // Process tick
         handle();    // Handle user input
         update(stepTimer.getTicks() / TIME_SECOND); // Update state values
         stepTimer.start(); //Restart step timer
         sync();    // Sync game to server
-        render();    // Render game state to window
 
-        ++countedFrames;
+        ++countedTicks;
+        FramePacket& packet = frames.back();
+        packet.tick = countedTicks;
+        packet.hud.ticksPerSecond = countedTicks / (tpsTimer.getTicks() / TIME_SECOND);
+        publish();
 
         if ((stepTimer.getTicks() / TIME_SECOND) > second) {
             GameManager::instance()->createZombieWave(1);
             second+=5;
         }
 
-        //If frame finished early
+        //If tick finished early
         if ((frameTicks = capTimer.getTicks()) < SCREEN_TICK_PER_FRAME) {
             //Wait remaining time
             SDL_Delay(SCREEN_TICK_PER_FRAME - frameTicks);
@@ -95,34 +154,91 @@ void GameStateMatch::loop() {
     }
 }
 
+/**
+ * Drains the SDL event queue on the thread that owns the window and copies the keyboard and
+ * mouse state and the window size, the simulation handles them at the start of its next tick
+ * and never touches SDL input or the Window itself.
+ */
+void GameStateMatch::pumpEvents() {
+    std::lock_guard<std::mutex> lock(inputMutex);
+    while (SDL_PollEvent(&event)) {
+        game.window.handleEvent(event);
+        switch (event.type) {
+            case SDL_RENDER_TARGETS_RESET:
+            case SDL_RENDER_DEVICE_RESET:
+                // the baked chunks lost their contents, and a new device may support render targets
+                background.invalidate();
+                failedBake = -1;
+                break;
+            default:
+                break;
+        }
+        pendingEvents.push_back(event);
+    }
+    memcpy(pendingKeys.data(), SDL_GetKeyboardState(nullptr), pendingKeys.size());
+    pendingMouse.buttons = SDL_GetMouseState(&pendingMouse.x, &pendingMouse.y);
+    pendingMouse.windowW = game.window.getWidth();
+    pendingMouse.windowH = game.window.getHeight();
+}
+
+/**
+ * Writes the view, the sprites in it and the hud into the packet being filled, then publishes it.
+ */
+void GameStateMatch::publish() {
+    FramePacket& packet = frames.back();
+
+    packet.view = camera.getViewport();
+    packet.sprites.clear();
+    GameManager::instance()->renderObjects(packet.view, packet.sprites);
+
+    packet.mapVersion = GameManager::instance()->getMapVersion();
+    packet.walls.clear();
+    for (const auto& w : GameManager::instance()->getWallManager()) {
+        packet.walls.push_back(w.second.getDestRect());
+    }
+
+    packet.hud.health = player.marine->getHealth();
+    const Weapon* weapon = player.marine->inventory.getCurrent();
+    packet.hud.armed = weapon != nullptr;
+    packet.hud.clip = packet.hud.armed ? weapon->getClip() : 0;
+    packet.hud.ammo = packet.hud.armed ? weapon->getAmmo() : 0;
+
+    frames.publish();
+}
+
 void GameStateMatch::sync() {
 
 }
 
 void GameStateMatch::handle() {
-    const Uint8 *state = SDL_GetKeyboardState(nullptr); // Keyboard state
+    {
+        std::lock_guard<std::mutex> lock(inputMutex);
+        events.swap(pendingEvents);
+        keys = pendingKeys;
+        mouse = pendingMouse;
+    }
+
     // Handle movement input
-    player.handleKeyboardInput(state);
-    player.handleMouseUpdate(game.window, camera.getX(), camera.getY());
-    //Handle events on queue
-    while (SDL_PollEvent(&event)) {
-        game.window.handleEvent(event);
-           switch(event.type) {
+    player.handleKeyboardInput(keys.data());
+    player.handleMouseUpdate(mouse, camera.getX(), camera.getY());
+    //Handle events queued since the last tick
+    for (SDL_Event& e : events) {
+           switch(e.type) {
         case SDL_WINDOWEVENT:
-            camera.setViewSize(game.window.getWidth(), game.window.getHeight());
+            camera.setViewSize(mouse.windowW, mouse.windowH);
             break;
         case SDL_MOUSEWHEEL:
-            player.handleMouseWheelInput(&(event));
+            player.handleMouseWheelInput(&(e));
             break;
         case SDL_MOUSEBUTTONDOWN:
-            if (event.button.button == SDL_BUTTON_RIGHT) {
+            if (e.button.button == SDL_BUTTON_RIGHT) {
                 player.handlePlacementClick(Renderer::instance()->getRenderer());
             }
             break;
         case SDL_KEYDOWN:
-            switch(event.key.keysym.sym) {
+            switch(e.key.keysym.sym) {
                 case SDLK_ESCAPE:
-                    play = false;
+                    running = false;
                     break;
                 case SDLK_b:
                     player.handleTempBarricade(Renderer::instance()->getRenderer());
@@ -132,58 +248,130 @@ void GameStateMatch::handle() {
             }
             break;
         case SDL_KEYUP:
-            switch(event.key.keysym.sym) {
+            switch(e.key.keysym.sym) {
                 default:
                    break;
             }
             break;
         case SDL_QUIT:
-            play = false;
+            running = false;
             break;
         default:
             break;
         }
     }
+    events.clear();
 }
 
 void GameStateMatch::update(const float delta) {
+    Animations::advance(delta);
     GameManager::instance()->updateCollider();
 
     // Move player
     GameManager::instance()->updateMarines(delta);
     GameManager::instance()->updateZombies(delta);
     GameManager::instance()->updateTurrets(delta);
+    GameManager::instance()->updateProjectiles(delta);
+    GameManager::instance()->applyDamage();
+    GameManager::instance()->despawnDead(delta);
 
     // Move Camera
     camera.move(player.marine->getX(), player.marine->getY());
 }
 
+/**
+ * Bakes the background over the map plus any wall built past its edge, rounded out to whole
+ * tiles so the baked ground lines up with the tiles still drawn around it. A failed bake is
+ * not retried for the same map version, render targets that are unsupported stay unsupported.
+ */
+void GameStateMatch::bakeBackground() {
+    SDL_Rect area = {0, 0, MAP_WIDTH, MAP_HEIGHT};
+
+    for (const auto& w : frame->walls) {
+        SDL_UnionRect(&area, &w, &area);
+    }
+
+    const int left = static_cast<int>(floor(static_cast<float>(area.x) / TEXTURE_SIZE)) * TEXTURE_SIZE;
+    const int top = static_cast<int>(floor(static_cast<float>(area.y) / TEXTURE_SIZE)) * TEXTURE_SIZE;
+    area = {left, top, area.x + area.w - left, area.y + area.h - top};
+
+    if (!background.bake(Renderer::instance()->getRenderer(), area, frame->walls, frame->mapVersion)) {
+        failedBake = frame->mapVersion;
+    }
+}
+
+/**
+ * Formats the hud into a buffer on the stack and queues it on the glyph atlas, the same
+ * strings come back frame after frame so their layouts are already cached.
+ */
+void GameStateMatch::renderHud() {
+    const HudValues& hud = frame->hud;
+    char line[HUD_TEXT_LENGTH];
+    int y = HUD_MARGIN;
+
+    snprintf(line, sizeof(line), "FPS: %.0f  TPS: %.0f", avgFPS, hud.ticksPerSecond);
+    hudText.draw(line, HUD_MARGIN, y, HUD_COLOUR);
+    y += hudText.getLineHeight();
+
+    snprintf(line, sizeof(line), "Health: %d", hud.health);
+    hudText.draw(line, HUD_MARGIN, y, HUD_COLOUR);
+    y += hudText.getLineHeight();
+
+    if (hud.armed) {
+        snprintf(line, sizeof(line), "Ammo: %d / %d", hud.clip, hud.ammo);
+        hudText.draw(line, HUD_MARGIN, y, HUD_COLOUR);
+    }
+}
+
+/**
+ * Draws the tick in frame, render thread only. Nothing here reads the GameManager, the
+ * simulation thread is already stepping the next tick.
+ */
 void GameStateMatch::render() {
     //Only draw when not minimized
     if (!game.window.isMinimized()) {
+        const SDL_Rect& view = frame->view;
 
         SDL_RenderClear(Renderer::instance()->getRenderer());
 
-        //Render textures
-        for (int i = camera.getX() / TEXTURE_SIZE - 1; ; ++i) {
+        if (background.getVersion() != frame->mapVersion && failedBake != frame->mapVersion) {
+            bakeBackground();
+        }
+        background.render(Renderer::instance()->getRenderer(), view);
+
+        //Render the tiles outside the baked background, all of them if baking failed
+        for (int i = view.x / TEXTURE_SIZE - 1; ; ++i) {
 
-            if (i * TEXTURE_SIZE - camera.getX() >= camera.getW()) {
+            if (i * TEXTURE_SIZE - view.x >= view.w) {
                 break;
             }
 
-            for (int j = camera.getY() / TEXTURE_SIZE - 1; ; ++j) {
-                if (j * TEXTURE_SIZE - camera.getY() >= camera.getH()) {
+            for (int j = view.y / TEXTURE_SIZE - 1; ; ++j) {
+                if (j * TEXTURE_SIZE - view.y >= view.h) {
                     break;
                 }
 
-                Renderer::instance()->render(
-                        {i * TEXTURE_SIZE - camera.getX(), j * TEXTURE_SIZE -camera.getY(), TEXTURE_SIZE, TEXTURE_SIZE},
-                        TEXTURES::BARREN);
+                if (background.covers({i * TEXTURE_SIZE, j * TEXTURE_SIZE, TEXTURE_SIZE, TEXTURE_SIZE})) {
+                    continue;
+                }
+                renderQueue.push(RenderLayer::BACKGROUND, TEXTURES::BARREN,
+                        {i * TEXTURE_SIZE - view.x, j * TEXTURE_SIZE - view.y, TEXTURE_SIZE, TEXTURE_SIZE});
+            }
+        }
+
+        //and the walls that are not baked, the simulation no longer queues them
+        for (const auto& w : frame->walls) {
+            if (SDL_HasIntersection(&w, &view) && !background.covers(w)) {
+                renderQueue.push(RenderLayer::OBJECTS, TEXTURES::CONCRETE, {w.x - view.x, w.y - view.y, w.w, w.h});
             }
         }
+        renderQueue.flush(Renderer::instance()->getRenderer());
+
+        //draws the objects the simulation queued for this tick, batched by layer and texture
+        frame->sprites.flush(Renderer::instance()->getRenderer());
 
-        //renders objects in game
-        GameManager::instance()->renderObjects(camera.getViewport());
+        renderHud();
+        hudText.flush(Renderer::instance()->getRenderer());
 
         //Update screen
         SDL_RenderPresent(Renderer::instance()->getRenderer());
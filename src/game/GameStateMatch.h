@@ -1,9 +1,12 @@
 #ifndef GAMESTATE_MATCH_H
 #define GAMESTATE_MATCH_H
 
+#include <array>
+#include <atomic>
+#include <mutex>
 #include <string>
-#include <sstream>
-#include <iomanip>
+#include <thread>
+#include <vector>
 
 #include "../basic/Entity.h"
 #include "../game/GameState.h"
@@ -13,8 +16,12 @@
 #include "../buildings/Base.h"
 #include "../creeps/Zombie.h"
 #include "../game/GameManager.h"
+#include "../game/FrameExchange.h"
 #include "../sprites/SpriteTypes.h"
 #include "../sprites/Renderer.h"
+#include "../sprites/RenderQueue.h"
+#include "../sprites/BackgroundLayer.h"
+#include "../sprites/GlyphAtlas.h"
 #include "../collision/CollisionHandler.h"
 #include "../view/Window.h"
 #include "../basic/LTimer.h"
@@ -22,10 +29,15 @@
 // ticks (ms) in 1 second
 static constexpr float TICK_SEC = 1000;
 
+static constexpr int HUD_FONT_SIZE = 24;
+static constexpr int HUD_MARGIN = 10; // pixels between the hud and the window edge
+static constexpr size_t HUD_TEXT_LENGTH = 32; // longest line of hud text
+static constexpr SDL_Color HUD_COLOUR = {0xFF, 0xFF, 0xFF, 0xFF};
+
 class GameStateMatch : public GameState {
 public:
     GameStateMatch(Game& g, int gameWidth, int gameHeight);
-    virtual ~GameStateMatch() = default;
+    virtual ~GameStateMatch();
 
     virtual bool load();
     virtual void loop();
@@ -33,13 +45,42 @@ public:
     GameManager* gameManager = nullptr;
 
     // Frame Display
-    std::stringstream frameTimeText;
-    //TTF_Font* frameFont = nullptr;
+    float avgFPS = 0;
 
 private:
     Player player;
     Base base;
     Camera camera;
+    RenderQueue renderQueue; // background tiles and unbaked walls drawn this frame
+    BackgroundLayer background; // ground and walls baked into chunks
+    int failedBake = -1; // map version the background could not be baked for, drawn per tile until it changes
+    TTF_Font* hudFont = nullptr;
+    GlyphAtlas hudText; // fps, health and ammo
+
+    // simulation thread, handle, update and sync run on it and hand their ticks to render through frames
+    std::thread simulation;
+    std::atomic<bool> running{false};
+    FrameExchange frames;
+    FramePacket* frame = nullptr; // tick being drawn, render thread only
+
+    // input gathered by the render thread for the next tick
+    std::mutex inputMutex;
+    std::vector<SDL_Event> pendingEvents;
+    std::array<Uint8, SDL_NUM_SCANCODES> pendingKeys{};
+    MouseState pendingMouse{};
+
+    // input of the tick being simulated, simulation thread only
+    std::vector<SDL_Event> events;
+    std::array<Uint8, SDL_NUM_SCANCODES> keys{};
+    MouseState mouse{};
+
+    void simulate(); // simulation thread loop
+    void pumpEvents(); // render thread, queues input and the window size for the simulation
+    void publish(); // writes the state of this tick into a frame packet
+
+    void renderHud(); // queues the hud text, formatted without allocating
+
+    void bakeBackground(); // bakes the ground under the map and its walls
 
     virtual void sync() override;
     virtual void handle() override;
@@ -9,6 +9,7 @@
 #include <unistd.h>
 
 #include "../game/GameStateMenu.h"
+#include "../game/AssetLoader.h"
 #include "../basic/LTimer.h"
 #include "../view/Window.h"
 #include "../sprites/Renderer.h"
@@ -93,6 +94,10 @@ bool GameStateMenu::load() {
         return false;
     }
 
+    if (!textboxGlyphs.load(Renderer::instance()->getRenderer(), textboxFont)) {
+        return false;
+    }
+
     return true;
 }
 
@@ -116,11 +121,13 @@ bool GameStateMenu::load() {
 * Notes:
 * Function acts as main loop for the menu game state
 * Listens for events and renders all assets to the screen
+* Sleeps in handle() until an event arrives, so an idle menu uses no CPU
 */
 void GameStateMenu::loop() {
 
     // State Loop
     while (play) {
+        AssetLoader::instance().pump(); // Upload the match assets loaded in the background
         handle(); // Handle user input
         render(); // Render game state to window
     }
@@ -172,65 +179,89 @@ void GameStateMenu::handle() {
 
     SDL_Keycode keyCode;
 
-    //Handle events on queue
-    SDL_WaitEvent(&event);
-    game.window.handleEvent(event);
-
-    switch (event.type) {
+    //Sleep until an event arrives, waking up regularly while match assets are waiting to be uploaded
+    if (AssetLoader::instance().ready(AssetGroup::MATCH)) {
+        SDL_WaitEvent(&event);
+    } else if (!SDL_WaitEventTimeout(&event, MENU_LOAD_POLL_MS)) {
+        return;
+    }
 
-        case SDL_MOUSEBUTTONDOWN:
-            // x = event.button.x;
-            // y = event.button.y;
+    //Handle the event and everything queued behind it before drawing
+    do {
+        game.window.handleEvent(event);
 
-            //move to the game when a click occurs
-            //changes the state to tell the Game.cpp loop to start the actual game
-            game.stateID = 2;
+        switch (event.type) {
 
-            //breaks out of the menu loop and Game.cpp re-evaluates the state
-            play = false;
-            break;
+            case SDL_MOUSEBUTTONDOWN:
+                // x = event.button.x;
+                // y = event.button.y;
 
-        case SDL_KEYDOWN:
-            keyCode = event.key.keysym.sym;
+                //move to the game when a click occurs
+                //changes the state to tell the Game.cpp loop to start the actual game
+                game.stateID = 2;
 
-            if (keyCode == SDLK_ESCAPE) {
+                //breaks out of the menu loop and Game.cpp re-evaluates the state
                 play = false;
-            }
-            break;
-
-        case SDL_TEXTINPUT:
-        //intentionally left blank for now
-        //only temporary, will be functional later
-            break;
-
-        case SDL_KEYUP: //Do nothing on key release
-        //intentionally left blank for now
-        //only temporary, will be functional later
-            break;
-
-        case SDL_MOUSEMOTION:
-        //intentionally left blank for now
-        //only temporary, will be functional later
-            break;
-
-        case SDL_WINDOWEVENT:
-            switch (event.window.event) {
-                case SDL_WINDOWEVENT_RESIZED:
-                    //Re-render with the new size
-                    //data1 --> new window width, | data2 --> new window height
-                    screenRect = {ZERO, ZERO, event.window.data1, event.window.data2};
                 break;
-            }
-            break;
 
-        case SDL_QUIT:
-            play = false;
-            game.stateID = 0;
-            break;
+            case SDL_KEYDOWN:
+                keyCode = event.key.keysym.sym;
 
-        default:
-            break;
-    }
+                if (keyCode == SDLK_ESCAPE) {
+                    play = false;
+                }
+                break;
+
+            case SDL_TEXTINPUT:
+            //intentionally left blank for now
+            //only temporary, will be functional later
+                break;
+
+            case SDL_KEYUP: //Do nothing on key release
+            //intentionally left blank for now
+            //only temporary, will be functional later
+                break;
+
+            case SDL_MOUSEMOTION:
+            //intentionally left blank for now
+            //only temporary, will be functional later
+                break;
+
+            case SDL_WINDOWEVENT:
+                switch (event.window.event) {
+                    case SDL_WINDOWEVENT_SIZE_CHANGED:
+                        //Re-position and re-compose with the new size
+                        //data1 --> new window width, | data2 --> new window height
+                        screenRect = {ZERO, ZERO, event.window.data1, event.window.data2};
+                        layoutDirty = true;
+                        dirty = true;
+                        break;
+                    case SDL_WINDOWEVENT_SHOWN:
+                    case SDL_WINDOWEVENT_EXPOSED:
+                    case SDL_WINDOWEVENT_RESTORED:
+                        //the window contents were lost, the composed frame is still good
+                        dirty = true;
+                        break;
+                }
+                break;
+
+            case SDL_RENDER_TARGETS_RESET:
+            case SDL_RENDER_DEVICE_RESET:
+                //the composed texture lost its contents
+                SDL_DestroyTexture(composed);
+                composed = nullptr;
+                dirty = true;
+                break;
+
+            case SDL_QUIT:
+                play = false;
+                game.stateID = 0;
+                break;
+
+            default:
+                break;
+        }
+    } while (play && SDL_PollEvent(&event));
 }
 
 /**
@@ -287,31 +318,22 @@ void GameStateMenu::positionElements() {
     int maxTextHeight = ZERO;
     int vertPadding = 100;
 
-    std::string longestString = "";
-    char largestChar = 'W';
-
-    //Check if TTF was initialized correctly
-    if(!TTF_WasInit() && TTF_Init()== -1) {
-        logv("TTF_Init: %s\n", TTF_GetError());
-        exit(1);
-    }
-
-    //Calculate the pixel length and height of the largest possible string
-    longestString.resize(maxLength + 1, largestChar);
-    TTF_SizeText(textboxFont, longestString.c_str(), &maxTextWidth, &maxTextHeight);
+    //Calculate the pixel length and height of the largest possible string, laid out once and cached
+    const SDL_Point longest = textboxGlyphs.measure(LONGEST_TEXTBOX_TEXT.c_str());
+    maxTextWidth = longest.x;
+    maxTextHeight = longest.y;
 
-
-    //Create a textbox for the server IP
-    hostIPTextBox.x = (screenRect.w - hostIPTextBox.w) * 0.5;
-    hostIPTextBox.y = screenRect.h * 0.5;
+    //Create a textbox for the server IP, sized before it is centred
     hostIPTextBox.w = maxTextWidth;
     hostIPTextBox.h = maxTextHeight;
+    hostIPTextBox.x = (screenRect.w - hostIPTextBox.w) * 0.5;
+    hostIPTextBox.y = screenRect.h * 0.5;
 
     //Create a textbox for the Username
-    usernameTextBox.x = (screenRect.w - usernameTextBox.w) * 0.5;
-    usernameTextBox.y = hostIPTextBox.y - vertPadding * 0.5;
     usernameTextBox.w = maxTextWidth;
     usernameTextBox.h = maxTextHeight;
+    usernameTextBox.x = (screenRect.w - usernameTextBox.w) * 0.5;
+    usernameTextBox.y = hostIPTextBox.y - vertPadding * 0.5;
 
     //Position the menu text
     joinRect.x = hostIPTextBox.x + hostIPTextBox.x * 0.25;
@@ -346,39 +368,80 @@ void GameStateMenu::positionElements() {
 * Returns: void
 *
 * Notes:
-* Function renders all assets to the screen
+* Function renders all assets to the screen, only when an event marked the window dirty
 * Changes the color of any assets that are selected
-* Calls helper function to position elements in the window
+* Calls helper function to position elements in the window after a resize
+* The elements are composed into one texture, later redraws copy it
 *
 * Revisions:
 * Now renders solely with the Renderer instance. (Michael Goll / March 16, 2017)
 */
 void GameStateMenu::render() {
-    //Only draw when not minimized
-    if (!game.window.isMinimized()) {
+    //Only draw when something changed and the window is not minimized
+    if (!dirty || game.window.isMinimized()) {
+        return;
+    }
 
-        screenRect = {ZERO, ZERO, game.window.getWidth(), game.window.getHeight()};
+    //Position all screen elements in the window, only after a resize
+    if (layoutDirty) {
+        positionElements();
+        SDL_DestroyTexture(composed);
+        composed = nullptr;
+        layoutDirty = false;
+    }
 
-        //Clear screen
-        SDL_RenderClear(Renderer::instance()->getRenderer());
+    if (composed == nullptr) {
+        compose();
+    }
 
-        //render the splash screen
-        Renderer::instance()->render(screenRect, TEXTURES::MAIN);
+    //Clear screen
+    SDL_RenderClear(Renderer::instance()->getRenderer());
 
-        //Position all screen elements in the window
-        positionElements();
+    if (composed != nullptr) {
+        SDL_RenderCopy(Renderer::instance()->getRenderer(), composed, nullptr, nullptr);
+    } else {
+        drawElements();
+    }
 
-        //textboxes
-        Renderer::instance()->render(usernameTextBox, TEXTURES::TEXTBOX);
-        Renderer::instance()->render(hostIPTextBox, TEXTURES::TEXTBOX);
+    //Update screen
+    SDL_RenderPresent(Renderer::instance()->getRenderer());
+    dirty = false;
+}
 
-        //Join and Options text
-        Renderer::instance()->render(joinRect, TEXTURES::JOIN_FONT);
-        Renderer::instance()->render(optionsRect, TEXTURES::OPTIONS_FONT);
+/**
+* Draws the menu into a texture the size of the window so redrawing it after an expose
+* is a single copy. Without render target support composed stays null and render()
+* draws the elements directly.
+*/
+void GameStateMenu::compose() {
+    SDL_Renderer * renderer = Renderer::instance()->getRenderer();
+    if (!SDL_RenderTargetSupported(renderer) || screenRect.w <= 0 || screenRect.h <= 0) {
+        return;
+    }
 
-        //Update screen
-        SDL_RenderPresent(Renderer::instance()->getRenderer());
+    if ((composed = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_TARGET,
+            screenRect.w, screenRect.h)) == nullptr) {
+        logv("Cannot create menu texture, error: %s\n", SDL_GetError());
+        return;
     }
+
+    SDL_SetRenderTarget(renderer, composed);
+    SDL_RenderClear(renderer);
+    drawElements();
+    SDL_SetRenderTarget(renderer, nullptr);
+}
+
+void GameStateMenu::drawElements() {
+    //render the splash screen
+    Renderer::instance()->render(screenRect, TEXTURES::MAIN);
+
+    //textboxes
+    Renderer::instance()->render(usernameTextBox, TEXTURES::TEXTBOX);
+    Renderer::instance()->render(hostIPTextBox, TEXTURES::TEXTBOX);
+
+    //Join and Options text
+    Renderer::instance()->render(joinRect, TEXTURES::JOIN_FONT);
+    Renderer::instance()->render(optionsRect, TEXTURES::OPTIONS_FONT);
 }
 
 /**
@@ -405,6 +468,7 @@ void GameStateMenu::render() {
 * Removed unnecessary free calls (Michael Goll / March 16, 2017)
 */
 GameStateMenu::~GameStateMenu() {
+    SDL_DestroyTexture(composed);
     TTF_CloseFont(textboxFont);
     TTF_CloseFont(headingFont);
     TTF_CloseFont(menuFont);
@@ -8,8 +8,11 @@
 
 #include "../game/Level.h"
 #include "../view/Camera.h"
+#include "../sprites/GlyphAtlas.h"
 
 static constexpr size_t maxLength = 15;
+//widest text a textbox has to fit, sizes the textboxes
+const std::string LONGEST_TEXTBOX_TEXT(maxLength + 1, 'W');
 
 //Color Data
 static constexpr SDL_Color SDL_WHITE_RGB = {255, 255, 255};
@@ -31,6 +34,7 @@ static constexpr size_t RED = 3;
 
 static constexpr int ZERO = 0;
 static constexpr int FONT_SIZE = 30;
+static constexpr int MENU_LOAD_POLL_MS = 50; //longest the menu sleeps while match assets still need uploading
 
 class GameStateMenu : public GameState {
 public:
@@ -48,12 +52,16 @@ private:
     virtual void handle() override;
     virtual void update(const float delta) override;
     void positionElements();
+    void drawElements(); //draws the splash screen, textboxes and labels
+    void compose(); //draws the elements once into the composed texture
     virtual void render() override;
 
     TTF_Font* headingFont;
     TTF_Font* textboxFont;
     TTF_Font* menuFont;
 
+    GlyphAtlas textboxGlyphs; // textbox font, measures the textboxes
+
     SDL_Rect usernameTextBox;
     SDL_Rect hostIPTextBox;
 
@@ -62,6 +70,10 @@ private:
 
     SDL_Rect screenRect;
 
+    bool dirty = true; //the window needs redrawing
+    bool layoutDirty = true; //the window changed size, elements have to be positioned again
+    SDL_Texture* composed = nullptr; //every element drawn at the current size, nullptr when stale
+
 };
 
 #endif
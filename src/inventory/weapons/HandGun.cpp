@@ -6,6 +6,6 @@
 
 HandGun::HandGun() : InstantWeapon(HandgunVars::TYPE, HandgunVars::RANGE, HandgunVars::DAMAGE,
         HandgunVars::CLIP, HandgunVars::CLIPMAX, HandgunVars::AMMO, HandgunVars::AOE, 
-        HandgunVars::RELOAD, HandgunVars::FIRERATE, HandgunVars::READY) {
+        HandgunVars::RELOAD, HandgunVars::FIRERATE, HandgunVars::READY, HandgunVars::PENETRATION) {
 
 }
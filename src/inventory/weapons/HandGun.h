@@ -20,6 +20,7 @@ namespace HandgunVars {
     constexpr int RELOAD = 3;
     constexpr int FIRERATE = 1000;
     constexpr bool READY = true;
+    constexpr int PENETRATION = 0;
 }
 
 
@@ -6,14 +6,14 @@
 #include "../../game/GameManager.h"
 #include "../../collision/CollisionHandler.h"
 #include "../../audio/AudioManager.h"
-#include <queue>
 #include <stdio.h>
 #include <iostream>
 #include "../../log/log.h"
 
 InstantWeapon::InstantWeapon(std::string type, int range, int damage,
-        int clip, int clipMax, int ammo, int AOE, int reloadSpeed, int fireRate, bool isReadyToFire)
-        : Weapon(type, range, damage, clip, clipMax, ammo, AOE, reloadSpeed, fireRate, isReadyToFire) {
+        int clip, int clipMax, int ammo, int AOE, int reloadSpeed, int fireRate, bool isReadyToFire,
+        int penetration)
+        : Weapon(type, range, damage, clip, clipMax, ammo, AOE, reloadSpeed, fireRate, isReadyToFire, penetration) {
 
 }
 
@@ -33,17 +33,9 @@ void InstantWeapon::fire(Marine &marine){
 
     //AudioManager::instance().playEffect(EFX_WLPISTOL);
 
-    //get all targets in line with the shot
-    std::priority_queue<const HitBox*> targets;
-    targets = collisionHandler.detectLineCollision(marine, getRange());
-    if(targets.empty()){
-        return;
+    //get all targets in line with the shot, closest first
+    DamageQueue &damageQueue = GameManager::instance()->getDamageQueue();
+    for (const auto& hit : collisionHandler.detectLineCollision(marine, getRange(), getPenetration())) {
+        damageQueue.push(hit.id, getDamage());
     }
-
-    //=======================================================
-    //only shoot the first target for now, will change this later
-    //to include penetration to shoot multiple targets with 1 bullet.
-    //targets.top()->attached->collidingProjectile(getDamage()); //broken
-    targets.pop();
-    //=======================================================
 }
@@ -10,7 +10,8 @@
 class InstantWeapon: public Weapon  {
 public:
     InstantWeapon(std::string type, int range, int damage,
-    int clip, int clipMax, int ammo, int AOE, int reloadSpeed, int fireRate, bool isReadyToFire);
+    int clip, int clipMax, int ammo, int AOE, int reloadSpeed, int fireRate, bool isReadyToFire,
+    int penetration = 0);
     ~InstantWeapon() = default;
 
 
@@ -0,0 +1,25 @@
+#include <cmath>
+
+#include "ProjectileWeapon.h"
+#include "../../game/GameManager.h"
+#include "../../log/log.h"
+
+ProjectileWeapon::ProjectileWeapon(std::string type, int range, int damage, int clip, int clipMax, int ammo,
+        int AOE, int reloadSpeed, int fireRate, bool isReadyToFire, int speed)
+        : Weapon(type, range, damage, clip, clipMax, ammo, AOE, reloadSpeed, fireRate, isReadyToFire), speed(speed) {
+
+}
+
+// Launches a projectile from the marine's centre in the direction it is facing.
+void ProjectileWeapon::fire(Marine &marine){
+    logv("ProjectileWeapon::fire()\n");
+
+    if(!reduceAmmo(1)){
+        return;
+    }
+
+    const double radians = (marine.getAngle() - 90) * M_PI / 180;
+    GameManager::instance()->getProjectilePool().spawn(marine.getX() + MARINE_WIDTH / 2,
+        marine.getY() + MARINE_HEIGHT / 2, speed * cos(radians), speed * sin(radians), getRange(),
+        getDamage(), getRAOE());
+}
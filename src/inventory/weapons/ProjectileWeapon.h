@@ -0,0 +1,24 @@
+#ifndef PROJECTILEWEAPON_H
+#define PROJECTILEWEAPON_H
+#include "Weapon.h"
+#include <string>
+
+/*
+ * A weapon whose shots travel, spawned into the GameManager's ProjectilePool.
+ * Shots expire after range pixels, rAOE is the radius they explode with, 0 for none.
+ */
+class ProjectileWeapon: public Weapon {
+public:
+    ProjectileWeapon(std::string type, int range, int damage, int clip, int clipMax, int ammo, int AOE,
+        int reloadSpeed, int fireRate, bool isReadyToFire, int speed);
+    ~ProjectileWeapon() = default;
+
+    int getSpeed() const { return speed; } //returns projectile speed in pixels per second
+
+    void fire(Marine &marine);
+
+protected:
+    int speed;
+};
+
+#endif
@@ -6,6 +6,6 @@
 
 Rifle::Rifle() : InstantWeapon(RifleVars::TYPE, RifleVars::RANGE, RifleVars::DAMAGE,
         RifleVars::CLIP,RifleVars::CLIPMAX, RifleVars::AMMO, RifleVars::AOE, RifleVars::RELOAD,
-        RifleVars::FIRERATE, RifleVars::READY) {
+        RifleVars::FIRERATE, RifleVars::READY, RifleVars::PENETRATION) {
 
 }
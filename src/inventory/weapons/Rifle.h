@@ -19,6 +19,7 @@ namespace RifleVars {
     constexpr int RELOAD = 3;
     constexpr int FIRERATE = 1000;
     constexpr bool READY = true;
+    constexpr int PENETRATION = 2;
 }
 
 class Rifle: public InstantWeapon {
@@ -0,0 +1,8 @@
+#include "RocketLauncher.h"
+
+RocketLauncher::RocketLauncher() : ProjectileWeapon(RocketLauncherVars::TYPE, RocketLauncherVars::RANGE,
+        RocketLauncherVars::DAMAGE, RocketLauncherVars::CLIP, RocketLauncherVars::CLIPMAX, RocketLauncherVars::AMMO,
+        RocketLauncherVars::AOE, RocketLauncherVars::RELOAD, RocketLauncherVars::FIRERATE, RocketLauncherVars::READY,
+        RocketLauncherVars::SPEED) {
+
+}
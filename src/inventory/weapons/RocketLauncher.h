@@ -0,0 +1,29 @@
+#ifndef ROCKETLAUNCHER_H
+#define ROCKETLAUNCHER_H
+#include "ProjectileWeapon.h"
+#include <string>
+
+using std::string;
+
+namespace RocketLauncherVars {
+    const string TYPE = "RocketLauncher";
+    constexpr int RANGE = 1200;
+    constexpr int DAMAGE = 300;
+    constexpr int CLIP = 1;
+    constexpr int CLIPMAX = 1;
+    constexpr int AMMO = 20;
+    constexpr int AOE = 150;
+    constexpr int RELOAD = 3;
+    constexpr int FIRERATE = 1500;
+    constexpr bool READY = true;
+    constexpr int SPEED = 900;
+}
+
+class RocketLauncher: public ProjectileWeapon {
+public:
+
+    RocketLauncher();
+    ~RocketLauncher() = default;
+};
+
+#endif
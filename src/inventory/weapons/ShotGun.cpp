@@ -3,9 +3,31 @@
         Edited by DericM 3/8/2017
 */
 #include "ShotGun.h"
+#include "../../game/GameManager.h"
+#include "../../log/log.h"
 
 ShotGun::ShotGun() : InstantWeapon(ShotgunVars::TYPE, ShotgunVars::RANGE, ShotgunVars::DAMAGE,
         ShotgunVars::CLIP, ShotgunVars::CLIPMAX, ShotgunVars::AMMO, ShotgunVars::AOE,
-        ShotgunVars::RELOAD, ShotgunVars::FIRERATE, ShotgunVars::READY) {
+        ShotgunVars::RELOAD, ShotgunVars::FIRERATE, ShotgunVars::READY, ShotgunVars::PENETRATION) {
 
 }
+
+// Fires all pellets in one batched cast, the weapon's damage is split between them.
+void ShotGun::fire(Marine &marine){
+    logv("ShotGun::fire()\n");
+
+    CollisionHandler &collisionHandler = GameManager::instance()->getCollisionHandler();
+
+    if(!reduceAmmo(1)){
+        return;
+    }
+
+    DamageQueue &damageQueue = GameManager::instance()->getDamageQueue();
+    const int pelletDamage = getDamage() / ShotgunVars::PELLETS;
+    for (const auto& pellet : collisionHandler.detectSpreadCollision(marine, getRange(), ShotgunVars::PELLETS,
+            ShotgunVars::SPREAD, getPenetration())) {
+        for (const auto& hit : pellet) {
+            damageQueue.push(hit.id, pelletDamage);
+        }
+    }
+}
@@ -20,6 +20,9 @@ namespace ShotgunVars {
     constexpr int RELOAD = 3;
     constexpr int FIRERATE = 600;
     constexpr bool READY = true;
+    constexpr int PENETRATION = 0;
+    constexpr int PELLETS = 12;
+    constexpr double SPREAD = 30; //cone the pellets are spread over, in degrees
 }
 
 class ShotGun: public InstantWeapon {
@@ -27,6 +30,8 @@ public:
 
     ShotGun();
     ~ShotGun() = default;
+
+    void fire(Marine &marine);
 };
 
 #endif
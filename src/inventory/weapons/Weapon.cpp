@@ -8,15 +8,17 @@
 #include "../../log/log.h"
 
 Weapon::Weapon(std::string type, int range, int damage, int clip, int clipMax, int ammo,int rAOE,
-        int reloadSpeed, int fireRate, bool isReadyToFire): type(type), range(range), damage(damage),
+        int reloadSpeed, int fireRate, bool isReadyToFire, int penetration): type(type), range(range), damage(damage),
         ammo(ammo), rAOE(rAOE), reloadSpeed(reloadSpeed), reloadTick(0), reloadDelay(200),
-        fireRate(fireRate), fireTick(0), isReadyToFire(isReadyToFire), wID(generateWID()){
+        fireRate(fireRate), fireTick(0), isReadyToFire(isReadyToFire), penetration(penetration),
+        wID(generateWID()){
 
 }
 
 Weapon::Weapon(const Weapon& w) : type(w.type), range(w.range), damage(w.damage), ammo(w.ammo),
             rAOE(w.rAOE), reloadSpeed(w.reloadSpeed), reloadTick(w.reloadTick), reloadDelay(w.reloadDelay),
-            fireRate(w.fireRate), fireTick(w.fireTick), isReadyToFire(w.isReadyToFire), wID(w.getId()){
+            fireRate(w.fireRate), fireTick(w.fireTick), isReadyToFire(w.isReadyToFire),
+            penetration(w.penetration), wID(w.getId()){
 }
 
 void Weapon::reloadClip(){
@@ -14,7 +14,8 @@ class Weapon {
 public:
 
     Weapon(std::string type = "no type", int range = 0, int damage = 0, int clip = 0, int clipMax = 0,
-            int ammo = 0, int rAOE = 0, int reloadSpeed = 0, int fireRate = 0, bool isReadyToFire = false);
+            int ammo = 0, int rAOE = 0, int reloadSpeed = 0, int fireRate = 0, bool isReadyToFire = false,
+            int penetration = 0);
     Weapon(const Weapon& w);
     ~Weapon() = default;
 
@@ -28,6 +29,7 @@ public:
     int getDamage() const { return damage; } //returns damage of weapon
     int getRange() const { return range; } //returns range of weapon
     int getFireRate() const { return fireRate; } //returns weapon rate of fire
+    int getPenetration() const { return penetration; } //returns how many targets a shot passes through
 
     void reloadClip();//resets clip to max amount
     bool reduceAmmo(const int rounds);
@@ -53,6 +55,7 @@ protected:
     int fireRate;
     int fireTick;
     bool isReadyToFire;
+    int penetration; //targets a shot passes through before stopping
     int32_t wID;
 
 };
@@ -2,13 +2,14 @@
 #include <iostream>
 #include <string>
 #include "game/Game.h"
+#include "sprites/Renderer.h"
 #include "log/log.h"
 #include <getopt.h>
 
 
 int main(int argc, char *argv[]) {
     int opt;
-    while((opt = getopt(argc, argv, "evo:")) != -1){
+    while((opt = getopt(argc, argv, "evso:")) != -1){
         switch(opt){
             case 'v'://verbose
                 log_verbose = 2;
@@ -19,8 +20,11 @@ int main(int argc, char *argv[]) {
             case 'o':
                 log_verbose = atoi(optarg);
                 break;
+            case 's'://software rendering
+                Renderer::setBackend(RenderBackend::SOFTWARE);
+                break;
             case '?':
-                printf("-v verbose\n-e error\nverbose enables error as well.");
+                printf("-v verbose\n-e error\n-s software rendering\nverbose enables error as well.");
                 break;
         }
     }
@@ -0,0 +1,118 @@
+#ifndef BITSTREAM_H
+#define BITSTREAM_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/*
+ * Packs fields of any width up to 32 bits back to back, least significant bit first.
+ * Bits gather in a 64 bit accumulator and go out a byte at a time, so a write is a shift and
+ * an or with no per bit loop.
+ */
+class BitWriter {
+public:
+    void clear() {data.clear(); accumulator = 0; pending = 0;}
+
+    void write(const uint32_t value, const int bits) {
+        accumulator |= static_cast<uint64_t>(value & mask(bits)) << pending;
+        pending += bits;
+        while (pending >= 8) {
+            data.push_back(static_cast<uint8_t>(accumulator));
+            accumulator >>= 8;
+            pending -= 8;
+        }
+    }
+
+    void writeBool(const bool value) {write(value, 1);}
+
+    /*
+     * Unsigned value in 2 + 0, 4, 12 or 32 bits, the smallest that holds it. Meant for counts
+     * and gaps between sorted ids, which are mostly 0 or small.
+     */
+    void writeUnsigned(const uint32_t value) {
+        if (value == 0) {
+            write(0, 2);
+        } else if (value < (1u << 4)) {
+            write(1, 2);
+            write(value, 4);
+        } else if (value < (1u << 12)) {
+            write(2, 2);
+            write(value, 12);
+        } else {
+            write(3, 2);
+            write(value, 32);
+        }
+    }
+
+    // pads the last byte with zeroes, call once before reading bytes()
+    void finish() {
+        if (pending > 0) {
+            data.push_back(static_cast<uint8_t>(accumulator));
+            accumulator = 0;
+            pending = 0;
+        }
+    }
+
+    const std::vector<uint8_t>& bytes() const {return data;}
+    size_t bitCount() const {return data.size() * 8 + pending;}
+
+    static uint32_t mask(const int bits) {return bits >= 32 ? UINT32_MAX : (1u << bits) - 1;}
+
+private:
+    std::vector<uint8_t> data;
+    uint64_t accumulator = 0;
+    int pending = 0; // bits in accumulator not yet in data
+};
+
+/*
+ * Reads back what a BitWriter wrote. Reading past the end returns zeroes and flags the
+ * stream, callers check ok() once after decoding instead of after every field.
+ */
+class BitReader {
+public:
+    BitReader(const uint8_t *data, const size_t size) : data(data), size(size) {}
+
+    uint32_t read(const int bits) {
+        while (available < bits) {
+            if (pos == size) {
+                underflow = true;
+                available = bits;
+                break;
+            }
+            accumulator |= static_cast<uint64_t>(data[pos++]) << available;
+            available += 8;
+        }
+        const uint32_t value = static_cast<uint32_t>(accumulator) & BitWriter::mask(bits);
+        accumulator >>= bits;
+        available -= bits;
+        return value;
+    }
+
+    bool readBool() {return read(1) != 0;}
+
+    uint32_t readUnsigned() {
+        switch (read(2)) {
+            case 0:
+                return 0;
+            case 1:
+                return read(4);
+            case 2:
+                return read(12);
+            default:
+                return read(32);
+        }
+    }
+
+    bool ok() const {return !underflow;}
+
+private:
+    const uint8_t *data;
+    size_t size;
+    size_t pos = 0;
+    uint64_t accumulator = 0;
+    int available = 0; // bits in accumulator not yet read
+    bool underflow = false;
+};
+
+#endif
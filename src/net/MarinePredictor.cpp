@@ -0,0 +1,81 @@
+#include <algorithm>
+#include <cmath>
+
+#include "MarinePredictor.h"
+
+void applyCommand(Movable& marine, const InputCommand& command, CollisionHandler& ch) {
+    const float step = marine.getVelocity() * command.ms / 1000.0f;
+    marine.setAngle(command.angle);
+    marine.move(command.moveX * step, command.moveY * step, ch);
+}
+
+void writeCommand(PacketWriter& packet, const InputCommand& command) {
+    packet.putU32(command.sequence);
+    packet.putU8(static_cast<uint8_t>(command.moveX));
+    packet.putU8(static_cast<uint8_t>(command.moveY));
+    packet.putU8(command.ms);
+    packet.putFloat(command.angle);
+}
+
+InputCommand readCommand(PacketReader& packet) {
+    InputCommand command;
+    command.sequence = packet.getU32();
+    command.moveX = std::max(-1, std::min(static_cast<int>(static_cast<int8_t>(packet.getU8())), 1));
+    command.moveY = std::max(-1, std::min(static_cast<int>(static_cast<int8_t>(packet.getU8())), 1));
+    command.ms = std::min(packet.getU8(), MAX_COMMAND_MS);
+    command.angle = packet.getFloat();
+    if (!std::isfinite(command.angle)) {
+        command.angle = 0;
+    }
+    return command;
+}
+
+const InputCommand& MarinePredictor::predict(Movable& marine, const int moveX, const int moveY, const float angle,
+        const float delta, CollisionHandler& ch) {
+    InputCommand& command = commands[next % PREDICTION_BUFFER];
+    command.sequence = next++;
+    command.moveX = std::max(-1, std::min(moveX, 1));
+    command.moveY = std::max(-1, std::min(moveY, 1));
+    command.ms = std::min<long>(lroundf(delta * 1000), MAX_COMMAND_MS);
+    command.angle = angle;
+
+    applyCommand(marine, command, ch);
+    return command;
+}
+
+/**
+ * Snapshots older than the last one reconciled are ignored. When the client ran more than
+ * PREDICTION_BUFFER commands ahead of the server the oldest were overwritten, only the
+ * buffered ones are replayed and the next snapshot corrects the rest.
+ */
+int MarinePredictor::reconcile(Movable& marine, const EntityState& authoritative, const uint32_t serverAcked,
+        CollisionHandler& ch) {
+    if (serverAcked < acked || serverAcked >= next) {
+        return 0;
+    }
+    acked = serverAcked;
+
+    const float predictedX = marine.getX();
+    const float predictedY = marine.getY();
+    const double angle = marine.getAngle(); // the client aims, the server only echoes it
+
+    marine.setPosition(positionOf(authoritative.x), positionOf(authoritative.y));
+    int replayed = 0;
+    for (uint32_t s = std::max(acked + 1, next > PREDICTION_BUFFER ? next - PREDICTION_BUFFER : 1); s < next; ++s) {
+        applyCommand(marine, commands[s % PREDICTION_BUFFER], ch);
+        ++replayed;
+    }
+    marine.setAngle(angle);
+
+    correction = hypotf(marine.getX() - predictedX, marine.getY() - predictedY);
+    return replayed;
+}
+
+void MarinePredictor::writeInput(PacketWriter& packet) const {
+    const uint32_t first = std::max<uint32_t>(next - std::min<uint32_t>(next - 1, INPUT_REDUNDANCY), acked + 1);
+    packet.putU8(static_cast<uint8_t>(PacketType::INPUT));
+    packet.putU8(next - first);
+    for (uint32_t s = first; s < next; ++s) {
+        writeCommand(packet, commands[s % PREDICTION_BUFFER]);
+    }
+}
@@ -0,0 +1,69 @@
+#ifndef MARINEPREDICTOR_H
+#define MARINEPREDICTOR_H
+
+#include <array>
+#include <cstdint>
+
+#include "../basic/Movable.h"
+#include "../collision/CollisionHandler.h"
+#include "NetProtocol.h"
+#include "Snapshot.h"
+
+// commands kept until the server applies them, about a second of client ticks
+static constexpr uint32_t PREDICTION_BUFFER = 64;
+// newest commands repeated in every INPUT, so one lost datagram loses no command
+static constexpr int INPUT_REDUNDANCY = 3;
+// longest a command may be held for, a stalled client does not teleport its marine
+static constexpr uint8_t MAX_COMMAND_MS = 100;
+
+/*
+ * One client tick of input for its marine: the keys Player::handleKeyboardInput reads as a
+ * direction on each axis, the aim and how long they were held. The server applies commands
+ * in sequence order and reports the last one it applied with every snapshot.
+ */
+struct InputCommand {
+    uint32_t sequence; // 0 is no command
+    int8_t moveX; // -1, 0 or 1
+    int8_t moveY;
+    uint8_t ms;
+    float angle; // degrees
+};
+
+// moves marine by command with Movable::move, the same step GameManager::updateMarines takes
+void applyCommand(Movable& marine, const InputCommand& command, CollisionHandler& ch);
+
+void writeCommand(PacketWriter& packet, const InputCommand& command);
+InputCommand readCommand(PacketReader& packet); // clamped to what a client may send
+
+/*
+ * Client side prediction of the client's own marine.
+ * Every tick's command is numbered, buffered and applied at once, so the marine answers the
+ * keys without waiting a round trip. When a snapshot arrives the marine is put back where the
+ * server had it after the last command it applied, and the commands the server has not seen
+ * yet are applied again on top. Replaying is only a Movable::move per command, well under a
+ * microsecond each, so resimulating a whole buffer fits in a frame.
+ */
+class MarinePredictor {
+public:
+    // numbers and buffers the command, then applies it to marine
+    const InputCommand& predict(Movable& marine, const int moveX, const int moveY, const float angle,
+        const float delta, CollisionHandler& ch);
+
+    // rewinds marine to the server's state after command acked and replays the newer ones, returns how many
+    int reconcile(Movable& marine, const EntityState& authoritative, const uint32_t acked, CollisionHandler& ch);
+
+    // INPUT carrying the newest commands, oldest first
+    void writeInput(PacketWriter& packet) const;
+
+    uint32_t getAcked() const {return acked;}
+    uint32_t getPending() const {return next - 1 - acked;} // commands the server has not applied
+    float getCorrection() const {return correction;} // pixels the last reconcile moved the marine
+
+private:
+    std::array<InputCommand, PREDICTION_BUFFER> commands; // by sequence % PREDICTION_BUFFER
+    uint32_t next = 1; // sequence of the next command
+    uint32_t acked = 0; // newest command the server applied
+    float correction = 0;
+};
+
+#endif
@@ -0,0 +1,102 @@
+#ifndef NETPROTOCOL_H
+#define NETPROTOCOL_H
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+static constexpr uint16_t SERVER_PORT = 4981;
+static constexpr int SERVER_TICK_RATE = 30; // authoritative ticks per second
+static constexpr int MAX_CLIENTS = 8;
+static constexpr uint32_t CLIENT_TIMEOUT_MS = 5000; // a client not heard from for this long is dropped
+
+// largest datagram sent, stays under the usual path MTU so nothing is fragmented
+static constexpr size_t MAX_PACKET_SIZE = 1200;
+
+// type, tick, last input command applied, part and parts of a STATE packet, the rest is a
+// slice of the encoded snapshot
+static constexpr size_t STATE_HEADER_SIZE = 13;
+static constexpr size_t STATE_PAYLOAD_SIZE = MAX_PACKET_SIZE - STATE_HEADER_SIZE;
+// parts a snapshot may be split into, a full one of about 10k zombies
+static constexpr int MAX_STATE_PARTS = 64;
+
+// first byte of every datagram
+enum class PacketType : uint8_t {
+    HELLO,   // client asks to join, with the width and height of its view
+    WELCOME, // server accepted the client and gave it a marine
+    FULL,    // server refused the client, every slot is taken
+    INPUT,   // client's newest numbered input commands for its marine
+    BYE,     // client leaves
+    STATE,   // part of the server's snapshot of a tick
+    ACK      // client received every part of a tick's snapshot, the server deltas against it from then on
+};
+
+/*
+ * Appends little endian fields to a datagram being built.
+ * Writes past MAX_PACKET_SIZE are dropped and flagged, a packet that overflowed must not be sent.
+ */
+class PacketWriter {
+public:
+    PacketWriter() {data.reserve(MAX_PACKET_SIZE);}
+
+    void clear() {data.clear(); overflow = false;}
+
+    void putU8(const uint8_t v) {put(&v, 1);}
+    void putU16(const uint16_t v) {const uint8_t b[2] = {uint8_t(v), uint8_t(v >> 8)}; put(b, 2);}
+    void putU32(const uint32_t v) {putU16(uint16_t(v)); putU16(uint16_t(v >> 16));}
+    void putI32(const int32_t v) {putU32(static_cast<uint32_t>(v));}
+    void putFloat(const float v) {uint32_t u; memcpy(&u, &v, 4); putU32(u);}
+    void putBytes(const uint8_t *bytes, const size_t n) {put(bytes, n);}
+
+    const uint8_t * getData() const {return data.data();}
+    size_t size() const {return data.size();}
+    size_t remaining() const {return MAX_PACKET_SIZE - data.size();}
+    bool overflowed() const {return overflow;}
+
+private:
+    std::vector<uint8_t> data;
+    bool overflow = false;
+
+    void put(const uint8_t *bytes, const size_t n) {
+        if (data.size() + n > MAX_PACKET_SIZE) {
+            overflow = true;
+            return;
+        }
+        data.insert(data.end(), bytes, bytes + n);
+    }
+};
+
+/*
+ * Reads the fields a PacketWriter wrote. Reading past the end returns zeroes and flags the
+ * packet, callers check ok() once after reading everything instead of after every field.
+ */
+class PacketReader {
+public:
+    PacketReader(const uint8_t *data, const size_t size) : data(data), size(size) {}
+
+    uint8_t getU8() {return have(1) ? data[pos++] : 0;}
+    uint16_t getU16() {const uint16_t lo = getU8(); return lo | (getU8() << 8);}
+    uint32_t getU32() {const uint32_t lo = getU16(); return lo | (static_cast<uint32_t>(getU16()) << 16);}
+    int32_t getI32() {return static_cast<int32_t>(getU32());}
+    float getFloat() {const uint32_t u = getU32(); float v; memcpy(&v, &u, 4); return v;}
+
+    bool ok() const {return !underflow;}
+    size_t remaining() const {return size - pos;}
+
+private:
+    const uint8_t *data;
+    size_t size;
+    size_t pos = 0;
+    bool underflow = false;
+
+    bool have(const size_t n) {
+        if (pos + n > size) {
+            underflow = true;
+            pos = size;
+            return false;
+        }
+        return true;
+    }
+};
+
+#endif
@@ -0,0 +1,312 @@
+#include <algorithm>
+
+#include "Snapshot.h"
+#include "../game/GameManager.h"
+
+// fields of a changed entity that differ from its baseline, CHANGE_BITS wide
+static constexpr uint32_t CHANGED_POSITION = 1 << 0;
+static constexpr uint32_t CHANGED_ANGLE = 1 << 1;
+static constexpr uint32_t CHANGED_HEALTH = 1 << 2;
+static constexpr uint32_t CHANGED_POSE = 1 << 3; // zombie state and direction
+static constexpr int CHANGE_BITS = 4;
+
+static constexpr int POSITION_DELTA_OFFSET = 1 << (POSITION_DELTA_BITS - 1);
+
+static bool hasAngle(const EntityKind kind) {
+    return kind == EntityKind::MARINE || kind == EntityKind::TURRET;
+}
+
+static bool hasPose(const EntityKind kind) {
+    return kind == EntityKind::ZOMBIE;
+}
+
+static uint16_t quantiseHealth(const int health) {
+    return std::min(std::max(health, 0), (1 << HEALTH_BITS) - 1);
+}
+
+// the fields of state that are compared and sent, quantised like a client receives them
+static EntityState makeState(const int32_t id, const EntityKind kind, const float x, const float y,
+        const double angle, const int health, const ZombieState state, const ZombieDirection direction) {
+    return {id, kind, quantisePosition(x), quantisePosition(y), quantiseAngle(angle), quantiseHealth(health),
+        static_cast<uint8_t>(state), static_cast<uint8_t>(static_cast<int>(direction) + 1)};
+}
+
+/**
+ * Copies the state of every marine, zombie, turret, barricade and weapon drop. Each manager
+ * is already ordered by id, the sort only interleaves them.
+ */
+void captureSnapshot(const uint32_t tick, Snapshot& snapshot) {
+    GameManager *gm = GameManager::instance();
+    const ZombieState none = ZombieState::ZOMBIE_IDLE;
+    const ZombieDirection nowhere = ZombieDirection::DIR_INVALID;
+
+    snapshot.tick = tick;
+    snapshot.entities.clear();
+
+    for (const auto& m : gm->getMarineManager()) {
+        snapshot.entities.push_back(makeState(m.first, EntityKind::MARINE, m.second.getX(), m.second.getY(),
+            m.second.getAngle(), m.second.getHealth(), none, nowhere));
+    }
+    for (const auto& z : gm->getZombies()) {
+        snapshot.entities.push_back(makeState(z.first, EntityKind::ZOMBIE, z.second.getX(), z.second.getY(), 0,
+            z.second.getHealth(), z.second.getState(), z.second.getCurDir()));
+    }
+    for (const auto& t : gm->getTurretManager()) {
+        snapshot.entities.push_back(makeState(t.first, EntityKind::TURRET, t.second.getX(), t.second.getY(),
+            t.second.getAngle(), t.second.getHealth(), none, nowhere));
+    }
+    for (const auto& b : gm->getBarricadeManager()) {
+        snapshot.entities.push_back(makeState(b.first, EntityKind::BARRICADE, b.second.getX(), b.second.getY(), 0,
+            b.second.getHealth(), none, nowhere));
+    }
+    for (const auto& w : gm->getWeaponDropManager()) {
+        snapshot.entities.push_back(makeState(w.first, EntityKind::WEAPON_DROP, w.second.getX(), w.second.getY(),
+            0, 0, none, nowhere));
+    }
+
+    std::sort(snapshot.entities.begin(), snapshot.entities.end(),
+        [](const EntityState& a, const EntityState& b) {return a.id < b.id;});
+}
+
+Snapshot& SnapshotHistory::add(const uint32_t tick) {
+    Snapshot& slot = snapshots[tick % SNAPSHOT_HISTORY];
+    slot.tick = tick;
+    slot.entities.clear();
+    return slot;
+}
+
+const Snapshot * SnapshotHistory::find(const uint32_t tick) const {
+    const Snapshot& slot = snapshots[tick % SNAPSHOT_HISTORY];
+    return tick != NO_TICK && slot.tick == tick ? &slot : nullptr;
+}
+
+// every field of a new entity, angle and pose only for the kinds that have them
+static void writeFull(BitWriter& out, const EntityState& e) {
+    out.write(static_cast<uint32_t>(e.kind), KIND_BITS);
+    out.write(e.x, POSITION_BITS);
+    out.write(e.y, POSITION_BITS);
+    if (hasAngle(e.kind)) {
+        out.write(e.angle, ANGLE_BITS);
+    }
+    out.write(e.health, HEALTH_BITS);
+    if (hasPose(e.kind)) {
+        out.write(e.state, STATE_BITS);
+        out.write(e.direction, DIRECTION_BITS);
+    }
+}
+
+static void readFull(BitReader& in, EntityState& e) {
+    e.kind = static_cast<EntityKind>(in.read(KIND_BITS));
+    e.x = in.read(POSITION_BITS);
+    e.y = in.read(POSITION_BITS);
+    e.angle = hasAngle(e.kind) ? in.read(ANGLE_BITS) : 0;
+    e.health = in.read(HEALTH_BITS);
+    e.state = hasPose(e.kind) ? in.read(STATE_BITS) : 0;
+    e.direction = hasPose(e.kind) ? in.read(DIRECTION_BITS) : 0;
+}
+
+// a difference of a few quarter pixels when it fits POSITION_DELTA_BITS, the whole coordinate otherwise
+static void writeCoordinate(BitWriter& out, const uint16_t value, const uint16_t base) {
+    const int difference = value - base;
+    if (difference >= -POSITION_DELTA_OFFSET && difference < POSITION_DELTA_OFFSET) {
+        out.writeBool(true);
+        out.write(difference + POSITION_DELTA_OFFSET, POSITION_DELTA_BITS);
+    } else {
+        out.writeBool(false);
+        out.write(value, POSITION_BITS);
+    }
+}
+
+static uint16_t readCoordinate(BitReader& in, const uint16_t base) {
+    if (in.readBool()) {
+        return base + static_cast<int>(in.read(POSITION_DELTA_BITS)) - POSITION_DELTA_OFFSET;
+    }
+    return in.read(POSITION_BITS);
+}
+
+static uint32_t changes(const EntityState& a, const EntityState& b) {
+    return (a.x != b.x || a.y != b.y ? CHANGED_POSITION : 0)
+        | (a.angle != b.angle ? CHANGED_ANGLE : 0)
+        | (a.health != b.health ? CHANGED_HEALTH : 0)
+        | (a.state != b.state || a.direction != b.direction ? CHANGED_POSE : 0);
+}
+
+int SnapshotCodec::entityBits(const EntityState& entity, const EntityState *previous) {
+    int bits = REMOVED_BITS + 1;
+    if (previous == nullptr || previous->kind != entity.kind) {
+        return bits + KIND_BITS + 2 * POSITION_BITS + (hasAngle(entity.kind) ? ANGLE_BITS : 0) + HEALTH_BITS
+            + (hasPose(entity.kind) ? STATE_BITS + DIRECTION_BITS : 0);
+    }
+
+    const uint32_t changed = changes(entity, *previous);
+    bits += CHANGE_BITS;
+    if (changed & CHANGED_POSITION) {
+        for (const int difference : {entity.x - previous->x, entity.y - previous->y}) {
+            bits += 1 + (difference >= -POSITION_DELTA_OFFSET && difference < POSITION_DELTA_OFFSET
+                ? POSITION_DELTA_BITS : POSITION_BITS);
+        }
+    }
+    bits += changed & CHANGED_ANGLE ? ANGLE_BITS : 0;
+    bits += changed & CHANGED_HEALTH ? HEALTH_BITS : 0;
+    bits += changed & CHANGED_POSE ? STATE_BITS + DIRECTION_BITS : 0;
+    return bits;
+}
+
+void SnapshotCodec::encode(const Snapshot& current, const Snapshot *baseline, BitWriter& out) {
+    static const std::vector<EntityState> nothing;
+    const std::vector<EntityState>& base = baseline != nullptr ? baseline->entities : nothing;
+    const std::vector<EntityState>& entities = current.entities;
+
+    removed.clear();
+    updated.clear();
+    previous.clear();
+
+    // both are sorted by id, one merge finds what was removed, added and changed
+    size_t i = 0;
+    size_t b = 0;
+    while (i < entities.size() || b < base.size()) {
+        if (b < base.size() && (i == entities.size() || base[b].id < entities[i].id)) {
+            removed.push_back(base[b++].id);
+        } else if (b < base.size() && base[b].id == entities[i].id) {
+            if (base[b].kind != entities[i].kind) {
+                updated.push_back(&entities[i]);
+                previous.push_back(nullptr);
+            } else if (changes(entities[i], base[b]) != 0) {
+                updated.push_back(&entities[i]);
+                previous.push_back(&base[b]);
+            }
+            ++i;
+            ++b;
+        } else {
+            updated.push_back(&entities[i++]);
+            previous.push_back(nullptr);
+        }
+    }
+
+    out.write(current.tick, 32);
+    out.write(baseline != nullptr ? baseline->tick : NO_TICK, 32);
+
+    int64_t last = -1;
+    out.writeUnsigned(removed.size());
+    for (const int32_t id : removed) {
+        out.writeUnsigned(id - last - 1);
+        last = id;
+    }
+
+    last = -1;
+    out.writeUnsigned(updated.size());
+    for (size_t u = 0; u < updated.size(); ++u) {
+        const EntityState& e = *updated[u];
+        out.writeUnsigned(e.id - last - 1);
+        last = e.id;
+
+        out.writeBool(previous[u] == nullptr);
+        if (previous[u] == nullptr) {
+            writeFull(out, e);
+            continue;
+        }
+
+        const EntityState& p = *previous[u];
+        const uint32_t changed = changes(e, p);
+        out.write(changed, CHANGE_BITS);
+        if (changed & CHANGED_POSITION) {
+            writeCoordinate(out, e.x, p.x);
+            writeCoordinate(out, e.y, p.y);
+        }
+        if (changed & CHANGED_ANGLE) {
+            out.write(e.angle, ANGLE_BITS);
+        }
+        if (changed & CHANGED_HEALTH) {
+            out.write(e.health, HEALTH_BITS);
+        }
+        if (changed & CHANGED_POSE) {
+            out.write(e.state, STATE_BITS);
+            out.write(e.direction, DIRECTION_BITS);
+        }
+    }
+    out.finish();
+}
+
+bool SnapshotCodec::readHeader(BitReader in, uint32_t& tick, uint32_t& baselineTick) {
+    tick = in.read(32);
+    baselineTick = in.read(32);
+    return in.ok();
+}
+
+/**
+ * Merges the baseline with the removed ids and the updates as they are read, the output
+ * comes out sorted by id like the snapshot that was encoded.
+ */
+bool SnapshotCodec::decode(BitReader& in, const Snapshot *baseline, Snapshot& out) {
+    const uint32_t tick = in.read(32);
+    const uint32_t baselineTick = in.read(32);
+    if (!in.ok() || (baselineTick != NO_TICK && (baseline == nullptr || baseline->tick != baselineTick))) {
+        return false;
+    }
+
+    static const std::vector<EntityState> nothing;
+    const std::vector<EntityState>& base = baselineTick != NO_TICK ? baseline->entities : nothing;
+
+    removed.clear();
+    int64_t last = -1;
+    for (uint32_t count = in.readUnsigned(); count > 0 && in.ok(); --count) {
+        last += static_cast<int64_t>(in.readUnsigned()) + 1;
+        removed.push_back(last);
+    }
+
+    out.tick = tick;
+    out.entities.clear();
+
+    size_t b = 0;
+    size_t r = 0;
+    // copies the baseline entities before id, skipping the removed ones
+    const auto keepUntil = [&](const int64_t id) {
+        for (; b < base.size() && base[b].id < id; ++b) {
+            while (r < removed.size() && removed[r] < base[b].id) {
+                ++r;
+            }
+            if (r == removed.size() || removed[r] != base[b].id) {
+                out.entities.push_back(base[b]);
+            }
+        }
+    };
+
+    last = -1;
+    for (uint32_t count = in.readUnsigned(); count > 0 && in.ok(); --count) {
+        last += static_cast<int64_t>(in.readUnsigned()) + 1;
+        keepUntil(last);
+
+        EntityState e;
+        if (in.readBool()) {
+            readFull(in, e);
+            if (b < base.size() && base[b].id == last) {
+                ++b;
+            }
+        } else {
+            if (b == base.size() || base[b].id != last) {
+                return false;
+            }
+            e = base[b++];
+            const uint32_t changed = in.read(CHANGE_BITS);
+            if (changed & CHANGED_POSITION) {
+                e.x = readCoordinate(in, e.x);
+                e.y = readCoordinate(in, e.y);
+            }
+            if (changed & CHANGED_ANGLE) {
+                e.angle = in.read(ANGLE_BITS);
+            }
+            if (changed & CHANGED_HEALTH) {
+                e.health = in.read(HEALTH_BITS);
+            }
+            if (changed & CHANGED_POSE) {
+                e.state = in.read(STATE_BITS);
+                e.direction = in.read(DIRECTION_BITS);
+            }
+        }
+        e.id = last;
+        out.entities.push_back(e);
+    }
+    keepUntil(INT64_MAX);
+
+    return in.ok();
+}
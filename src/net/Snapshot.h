@@ -0,0 +1,130 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "BitStream.h"
+
+// tick of no snapshot, the baseline of a snapshot sent in full
+static constexpr uint32_t NO_TICK = UINT32_MAX;
+
+// snapshots kept to delta against, a client acknowledging one older than this gets a full one
+static constexpr int SNAPSHOT_HISTORY = 32;
+
+// positions are sent in quarter pixels from POSITION_ORIGIN, 16 bits cover the map and its walls
+static constexpr float POSITION_SCALE = 4;
+static constexpr float POSITION_ORIGIN = -1024;
+static constexpr int POSITION_BITS = 16;
+// a position that moved less than this many quarter pixels since the baseline is sent as a difference
+static constexpr int POSITION_DELTA_BITS = 7;
+
+static constexpr int ANGLE_BITS = 8; // 256 headings
+static constexpr int HEALTH_BITS = 10; // health is clamped to 0 - 1023
+static constexpr int KIND_BITS = 3;
+static constexpr int STATE_BITS = 2; // ZombieState
+static constexpr int DIRECTION_BITS = 4; // ZombieDirection + 1
+
+// which manager an entity of a snapshot lives in
+enum class EntityKind : uint8_t {
+    MARINE,
+    ZOMBIE,
+    TURRET,
+    BARRICADE,
+    WEAPON_DROP
+};
+
+/*
+ * What a client needs to draw one entity, already quantised to what is sent so a snapshot
+ * compares with its baseline exactly. Zombies also carry their ZombieState and
+ * ZombieDirection, marines and turrets their angle.
+ */
+struct EntityState {
+    int32_t id;
+    EntityKind kind;
+    uint16_t x;
+    uint16_t y;
+    uint8_t angle;
+    uint16_t health;
+    uint8_t state;
+    uint8_t direction; // ZombieDirection + 1, so DIR_INVALID is 0
+};
+
+inline bool sameState(const EntityState& a, const EntityState& b) {
+    return a.id == b.id && a.kind == b.kind && a.x == b.x && a.y == b.y && a.angle == b.angle && a.health == b.health
+        && a.state == b.state && a.direction == b.direction;
+}
+
+inline uint16_t quantisePosition(const float p) {
+    const long q = lroundf((p - POSITION_ORIGIN) * POSITION_SCALE);
+    return q < 0 ? 0 : q > UINT16_MAX ? UINT16_MAX : q;
+}
+
+inline float positionOf(const uint16_t q) {return q / POSITION_SCALE + POSITION_ORIGIN;}
+
+// degrees, any range
+inline uint8_t quantiseAngle(const double degrees) {
+    return static_cast<uint8_t>(lround(degrees * (1 << ANGLE_BITS) / 360) & ((1 << ANGLE_BITS) - 1));
+}
+
+// degrees, 0 - 360
+inline float angleOf(const uint8_t q) {return q * 360.0f / (1 << ANGLE_BITS);}
+
+// every entity of the level at the end of a tick, sorted by id
+struct Snapshot {
+    uint32_t tick = NO_TICK;
+    std::vector<EntityState> entities;
+};
+
+// fills snapshot with the entities in the GameManager, reusing its storage
+void captureSnapshot(const uint32_t tick, Snapshot& snapshot);
+
+/*
+ * Snapshots by tick, the last SNAPSHOT_HISTORY of them. The server keeps what it sent to
+ * delta against whichever one a client acknowledges, the client what it received to apply
+ * those deltas to.
+ */
+class SnapshotHistory {
+public:
+    Snapshot& add(const uint32_t tick); // slot for tick, overwriting the oldest
+    const Snapshot * find(const uint32_t tick) const; // nullptr when tick is too old or was never added
+
+private:
+    std::array<Snapshot, SNAPSHOT_HISTORY> snapshots;
+};
+
+/*
+ * Delta compressed snapshot encoding.
+ * A snapshot is written as the ids of the baseline's entities it no longer has, then every
+ * entity that is new or changed since the baseline, both in id order with ids written as the
+ * gap from the previous one. A new entity is written in full. A changed one writes a 4 bit
+ * mask of what changed, position, angle, health and zombie state and direction, followed by
+ * only those fields, positions as a small signed difference when they moved a little.
+ * Unchanged entities cost nothing. Without a baseline every entity is new.
+ * The encoder and decoder keep scratch space between calls, use one of each per thread.
+ */
+class SnapshotCodec {
+public:
+    // writes current as a delta from baseline, nullptr to write it in full
+    void encode(const Snapshot& current, const Snapshot *baseline, BitWriter& out);
+
+    // tick and baseline tick of an encoded snapshot, read before decode to look the baseline up
+    static bool readHeader(BitReader in, uint32_t& tick, uint32_t& baselineTick);
+
+    // rebuilds the snapshot encode was given, from the same baseline, returns false if the data is malformed
+    bool decode(BitReader& in, const Snapshot *baseline, Snapshot& out);
+
+    // bits encode spends on entity, new when previous is nullptr, assuming a gap from the last id under 16
+    static int entityBits(const EntityState& entity, const EntityState *previous);
+    static constexpr int REMOVED_BITS = 6; // a removed id, with the same assumption
+    static constexpr int HEADER_BITS = 92; // ticks and both counts at their largest
+
+private:
+    std::vector<int32_t> removed;
+    std::vector<const EntityState *> updated;
+    std::vector<const EntityState *> previous; // baseline entity of each updated one, nullptr when new
+};
+
+#endif
@@ -0,0 +1,46 @@
+#include <cstring>
+
+#include "SnapshotAssembler.h"
+
+bool SnapshotAssembler::add(const uint8_t *datagram, const size_t length) {
+    PacketReader packet(datagram, length);
+    packet.getU8();
+    const uint32_t partTick = packet.getU32();
+    const uint32_t partSequence = packet.getU32();
+    const int part = packet.getU16();
+    const int partCount = packet.getU16();
+    if (!packet.ok() || partCount == 0 || partCount > MAX_STATE_PARTS || part >= partCount) {
+        return false;
+    }
+
+    if (completed != NO_TICK && partTick <= completed) {
+        return false;
+    }
+    if (tick == NO_TICK || partTick > tick) {
+        tick = partTick;
+        inputSequence = partSequence;
+        parts = partCount;
+        received = 0;
+        have.reset();
+        data.resize(parts * STATE_PAYLOAD_SIZE);
+        size = 0;
+    } else if (partTick < tick || partCount != parts || have[part]) {
+        return false;
+    }
+
+    const size_t payload = packet.remaining();
+    if (payload > STATE_PAYLOAD_SIZE || (part < parts - 1 && payload != STATE_PAYLOAD_SIZE)) {
+        return false;
+    }
+    memcpy(&data[part * STATE_PAYLOAD_SIZE], datagram + STATE_HEADER_SIZE, payload);
+    if (part == parts - 1) {
+        size = (parts - 1) * STATE_PAYLOAD_SIZE + payload;
+    }
+    have[part] = true;
+
+    if (++received < parts) {
+        return false;
+    }
+    completed = tick;
+    return true;
+}
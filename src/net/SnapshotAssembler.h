@@ -0,0 +1,38 @@
+#ifndef SNAPSHOTASSEMBLER_H
+#define SNAPSHOTASSEMBLER_H
+
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "NetProtocol.h"
+#include "Snapshot.h"
+
+/*
+ * Puts an encoded snapshot back together from its STATE packets, whatever order they arrive in.
+ * Only the newest tick is assembled: a part of an older tick is dropped and a part of a newer
+ * one abandons the tick being assembled, whose snapshot the server will delta past anyway.
+ */
+class SnapshotAssembler {
+public:
+    // takes a whole STATE datagram, true when it was the last part missing from its tick
+    bool add(const uint8_t *datagram, const size_t size);
+
+    uint32_t getTick() const {return tick;}
+    uint32_t getInputSequence() const {return inputSequence;} // last input command the server applied by then
+    const uint8_t * getData() const {return data.data();} // the encoded snapshot once add returned true
+    size_t getSize() const {return size;}
+
+private:
+    uint32_t tick = NO_TICK;
+    uint32_t inputSequence = 0;
+    uint32_t completed = NO_TICK; // newest tick assembled, its parts arriving again are ignored
+    int parts = 0;
+    int received = 0;
+    std::bitset<MAX_STATE_PARTS> have;
+    std::vector<uint8_t> data;
+    size_t size = 0;
+};
+
+#endif
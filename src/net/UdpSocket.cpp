@@ -0,0 +1,75 @@
+#include <arpa/inet.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "UdpSocket.h"
+#include "../log/log.h"
+
+NetAddress loopbackAddress(const uint16_t port) {
+    return {htonl(INADDR_LOOPBACK), htons(port)};
+}
+
+UdpSocket::~UdpSocket() {
+    close();
+}
+
+bool UdpSocket::open(const uint16_t port) {
+    close();
+    if ((fd = socket(AF_INET, SOCK_DGRAM, 0)) < 0) {
+        loge("Cannot create socket, error: %s\n", strerror(errno));
+        return false;
+    }
+
+    sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = htons(port);
+
+    if (bind(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) < 0
+            || fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK) < 0) {
+        loge("Cannot bind port %u, error: %s\n", port, strerror(errno));
+        close();
+        return false;
+    }
+    return true;
+}
+
+void UdpSocket::close() {
+    if (fd >= 0) {
+        ::close(fd);
+        fd = -1;
+    }
+}
+
+uint16_t UdpSocket::getPort() const {
+    sockaddr_in addr = {};
+    socklen_t length = sizeof(addr);
+    if (fd < 0 || getsockname(fd, reinterpret_cast<sockaddr *>(&addr), &length) < 0) {
+        return 0;
+    }
+    return ntohs(addr.sin_port);
+}
+
+bool UdpSocket::send(const NetAddress& to, const uint8_t *data, const size_t size) {
+    sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = to.host;
+    addr.sin_port = to.port;
+
+    return sendto(fd, data, size, 0, reinterpret_cast<sockaddr *>(&addr), sizeof(addr))
+        == static_cast<ssize_t>(size);
+}
+
+size_t UdpSocket::receive(uint8_t *buffer, const size_t capacity, NetAddress& from) {
+    sockaddr_in addr = {};
+    socklen_t length = sizeof(addr);
+    const ssize_t received = recvfrom(fd, buffer, capacity, 0, reinterpret_cast<sockaddr *>(&addr), &length);
+    if (received <= 0) {
+        return 0;
+    }
+    from = {addr.sin_addr.s_addr, addr.sin_port};
+    return received;
+}
@@ -0,0 +1,45 @@
+#ifndef UDPSOCKET_H
+#define UDPSOCKET_H
+
+#include <netinet/in.h>
+#include <cstddef>
+#include <cstdint>
+
+// an IPv4 address and port, compared when matching datagrams to clients
+struct NetAddress {
+    uint32_t host; // network byte order
+    uint16_t port; // network byte order
+
+    bool operator==(const NetAddress& other) const {return host == other.host && port == other.port;}
+    bool operator!=(const NetAddress& other) const {return !(*this == other);}
+};
+
+// address of port on the loopback interface
+NetAddress loopbackAddress(const uint16_t port);
+
+/*
+ * Non-blocking IPv4 UDP socket bound to the loopback interface.
+ * Receiving returns straight away when nothing is queued, so the server and the clients poll
+ * it once per tick instead of dedicating a thread to it.
+ */
+class UdpSocket {
+public:
+    UdpSocket() = default;
+    ~UdpSocket();
+    UdpSocket(const UdpSocket&) = delete;
+    UdpSocket& operator=(const UdpSocket&) = delete;
+
+    bool open(const uint16_t port); // binds to port on loopback, 0 picks a free one, returns success
+    void close();
+    bool isOpen() const {return fd >= 0;}
+    uint16_t getPort() const; // port bound to, host byte order
+
+    bool send(const NetAddress& to, const uint8_t *data, const size_t size);
+    // returns the size of the next queued datagram copied into buffer, 0 when none is queued
+    size_t receive(uint8_t *buffer, const size_t capacity, NetAddress& from);
+
+private:
+    int fd = -1;
+};
+
+#endif
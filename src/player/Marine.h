@@ -28,6 +28,7 @@ public:
     void collidingProjectile(int damage);
     void fireWeapon();
     int32_t checkForPickUp();
+    int getHealth() const {return health;}
     Inventory inventory;
 
 private:
@@ -15,16 +15,15 @@ void Player::setControl(Marine& newControl) {
 }
 
 
-void Player::handleMouseUpdate(Window& w, float camX, float camY) {
-    int mouseX;
-    int mouseY;
+void Player::handleMouseUpdate(const MouseState& mouse, float camX, float camY) {
+    const int mouseX = mouse.x;
+    const int mouseY = mouse.y;
     int mouseDeltaX;
     int mouseDeltaY;
     double radianConvert = 180.0000;
 
-    SDL_GetMouseState(&mouseX, &mouseY);
-    mouseDeltaX = w.getWidth()/2 - mouseX;
-    mouseDeltaY = w.getHeight()/2 - mouseY;
+    mouseDeltaX = mouse.windowW/2 - mouseX;
+    mouseDeltaY = mouse.windowH/2 - mouseY;
 
     double angle = ((atan2(mouseDeltaX, mouseDeltaY)* radianConvert)/M_PI) * - 1;
 
@@ -41,7 +40,7 @@ void Player::handleMouseUpdate(Window& w, float camX, float camY) {
         tempTurret.move(marine->getX(), marine->getY(), mouseX + camX, mouseY + camY,
             GameManager::instance()->getCollisionHandler());
 
-        if (SDL_GetMouseState(nullptr, nullptr) & SDL_BUTTON(SDL_BUTTON_RIGHT)) {
+        if (mouse.buttons & SDL_BUTTON(SDL_BUTTON_RIGHT)) {
             if (tempTurret.collisionCheckTurret(marine->getX(), marine->getY(), mouseX + camX, mouseY + camY,
                     GameManager::instance()->getCollisionHandler())) {
                 tempTurret.placeTurret();
@@ -52,7 +51,7 @@ void Player::handleMouseUpdate(Window& w, float camX, float camY) {
     }
 
     //fire weapon on left mouse click
-    if (SDL_GetMouseState(nullptr, nullptr) & SDL_BUTTON(SDL_BUTTON_LEFT)) {
+    if (mouse.buttons & SDL_BUTTON(SDL_BUTTON_LEFT)) {
         if(marine->inventory.getCurrent() != nullptr) {
             if(marine->inventory.getCurrent()->getFireState()) {
                 marine->fireWeapon();
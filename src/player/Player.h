@@ -11,12 +11,21 @@
 
 constexpr int PLAYER_PLACE_DISTANCE = 100;
 
+// the mouse and the window size as the thread owning the window last read them
+struct MouseState {
+    int x;
+    int y;
+    Uint32 buttons; // SDL_BUTTON mask
+    int windowW;
+    int windowH;
+};
+
 class Player {
 public:
 
 
     void handleKeyboardInput(const Uint8 *state); // Handles player input with keyboard state
-    void handleMouseUpdate(Window& w, float camX, float camY);
+    void handleMouseUpdate(const MouseState& mouse, float camX, float camY);
 
     void setControl(Marine& newControl);
 
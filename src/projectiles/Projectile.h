@@ -0,0 +1,21 @@
+#ifndef PROJECTILE_H
+#define PROJECTILE_H
+
+#include <cstdint>
+
+static constexpr int PROJECTILE_SIZE = 8; // width and height of a projectile's hitbox
+
+/*
+ * A bullet, rocket or shell in flight. Plain data so the pool can keep them packed together.
+ */
+struct Projectile {
+    float x; // centre of the projectile
+    float y;
+    float dx; // velocity in pixels per second
+    float dy;
+    float range; // distance left before it expires
+    int damage; // damage dealt to whatever it hits, or to everything in rAOE
+    int rAOE; // radius of the explosion, 0 for projectiles that only hit one target
+};
+
+#endif
@@ -0,0 +1,173 @@
+#include <algorithm>
+#include <cmath>
+
+#include "ProjectilePool.h"
+#include "../log/log.h"
+
+ProjectilePool::ProjectilePool(const size_t capacity) : capacity(capacity) {
+    projectiles.reserve(capacity);
+}
+
+bool ProjectilePool::spawn(const float x, const float y, const float dx, const float dy, const float range,
+        const int damage, const int rAOE) {
+    if (projectiles.size() >= capacity) {
+        logv("Projectile pool full\n");
+        return false;
+    }
+    projectiles.push_back({x, y, dx, dy, range, damage, rAOE});
+    return true;
+}
+
+void ProjectilePool::clear() {
+    projectiles.clear();
+}
+
+/**
+ * Returns the fraction of the move (mx, my) from (x, y) at which a projectile first touches rect,
+ * or a value above 1 if it doesn't touch it during this move. Sweeping the projectile's box
+ * is the same as casting its centre against rect grown by half the projectile's size.
+ */
+static float sweep(const float x, const float y, const float mx, const float my, const SDL_Rect& rect) {
+    constexpr float half = PROJECTILE_SIZE / 2.0f;
+    const float left = rect.x - half;
+    const float right = rect.x + rect.w + half;
+    const float top = rect.y - half;
+    const float bottom = rect.y + rect.h + half;
+
+    float tMin = 0;
+    float tMax = 1;
+
+    // slab test on one axis, false if the move misses the slab
+    auto slab = [&](const float start, const float move, const float low, const float high) {
+        if (move == 0) {
+            return start >= low && start <= high;
+        }
+        float t1 = (low - start) / move;
+        float t2 = (high - start) / move;
+        if (t1 > t2) {
+            std::swap(t1, t2);
+        }
+        tMin = std::max(tMin, t1);
+        tMax = std::min(tMax, t2);
+        return tMin <= tMax;
+    };
+
+    if (!slab(x, mx, left, right) || !slab(y, my, top, bottom)) {
+        return 2;
+    }
+    return tMin;
+}
+
+// Damages every zombie whose centre is within radius of (x, y).
+static void explode(const float x, const float y, const int damage, const int radius,
+        const SpatialGrid& zombies, DamageQueue& damageQueue, std::vector<Entity *>& candidates) {
+    const SDL_Rect area = {static_cast<int>(x) - radius, static_cast<int>(y) - radius, radius * 2, radius * 2};
+    const float radiusSq = static_cast<float>(radius) * radius;
+
+    candidates.clear();
+    zombies.retrieve(area, candidates);
+    for (const auto zombie : candidates) {
+        const SDL_Rect& rect = zombie->getProHitBox().getRect();
+        const float xDelta = rect.x + rect.w / 2.0f - x;
+        const float yDelta = rect.y + rect.h / 2.0f - y;
+        if (xDelta * xDelta + yDelta * yDelta <= radiusSq) {
+            damageQueue.push(zombie->getId(), damage);
+        }
+    }
+}
+
+/**
+ * Moves one projectile by delta seconds, returns false once it has expired.
+ * It sweeps its box along its move against the zombies and walls around it and stops at the
+ * first thing it touches. Projectiles with an area of effect explode where they stop, or at
+ * the end of their range.
+ */
+static bool step(Projectile& p, const float delta, const SpatialGrid& zombies, const Quadtree& walls,
+        DamageQueue& damageQueue, std::vector<Entity *>& candidates) {
+    const float mx = p.dx * delta;
+    const float my = p.dy * delta;
+    const float length = std::hypot(mx, my);
+
+    const SDL_Rect swept = {static_cast<int>(std::min(p.x, p.x + mx) - PROJECTILE_SIZE / 2),
+        static_cast<int>(std::min(p.y, p.y + my) - PROJECTILE_SIZE / 2),
+        static_cast<int>(std::abs(mx)) + PROJECTILE_SIZE + 1, static_cast<int>(std::abs(my)) + PROJECTILE_SIZE + 1};
+
+    candidates.clear();
+    zombies.retrieve(swept, candidates);
+    const size_t zombieCount = candidates.size();
+    walls.retrieve(swept, candidates);
+
+    float hitTime = 2;
+    Entity *hit = nullptr;
+    bool hitWall = false;
+    for (size_t c = 0; c < candidates.size(); ++c) {
+        const SDL_Rect& rect = candidates[c]->getProHitBox().getRect();
+        if (!SDL_HasIntersection(&swept, &rect)) {
+            continue;
+        }
+        const float t = sweep(p.x, p.y, mx, my, rect);
+        if (t < hitTime) {
+            hitTime = t;
+            hit = candidates[c];
+            hitWall = c >= zombieCount;
+        }
+    }
+
+    // the move is cut short by the range left
+    const float reach = length > p.range ? p.range / length : 1;
+
+    if (hit != nullptr && hitTime <= reach) {
+        if (p.rAOE > 0) {
+            explode(p.x + mx * hitTime, p.y + my * hitTime, p.damage, p.rAOE, zombies, damageQueue, candidates);
+        } else if (!hitWall) {
+            damageQueue.push(hit->getId(), p.damage);
+        }
+        return false;
+    }
+
+    if (length < p.range) {
+        p.x += mx;
+        p.y += my;
+        p.range -= length;
+        return true;
+    }
+
+    if (p.rAOE > 0) {
+        explode(p.x + mx * reach, p.y + my * reach, p.damage, p.rAOE, zombies, damageQueue, candidates);
+    }
+    return false;
+}
+
+/**
+ * Moves every projectile by delta seconds, hits are pushed to damageQueue.
+ * Projectiles only read the world while they move, so they are stepped in parallel,
+ * then the expired ones are swapped out.
+ */
+void ProjectilePool::update(const float delta, const SpatialGrid& zombies, const Quadtree& walls,
+        DamageQueue& damageQueue) {
+    const int count = projectiles.size();
+    expired.assign(count, false);
+
+    #pragma omp parallel
+    {
+        std::vector<Entity *> candidates;
+
+        #pragma omp for schedule(static)
+        for (int i = 0; i < count; ++i) {
+            expired[i] = !step(projectiles[i], delta, zombies, walls, damageQueue, candidates);
+        }
+    }
+
+    size_t i = 0;
+    while (i < projectiles.size()) {
+        if (expired[i]) {
+            // move the last projectile into the expired one's slot
+            projectiles[i] = projectiles.back();
+            expired[i] = expired.back();
+            projectiles.pop_back();
+            expired.pop_back();
+        } else {
+            ++i;
+        }
+    }
+}
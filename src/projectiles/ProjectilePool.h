@@ -0,0 +1,40 @@
+#ifndef PROJECTILEPOOL_H
+#define PROJECTILEPOOL_H
+
+#include <SDL2/SDL.h>
+#include <vector>
+
+#include "Projectile.h"
+#include "../collision/Quadtree.h"
+#include "../collision/SpatialGrid.h"
+#include "../game/DamageQueue.h"
+
+static constexpr size_t PROJECTILE_POOL_SIZE = 16384; // most projectiles alive at once
+
+/*
+ * Every projectile in flight, packed in one array that is reserved up front.
+ * Expired projectiles are swapped with the last one so the array never has holes.
+ */
+class ProjectilePool {
+public:
+    ProjectilePool(const size_t capacity = PROJECTILE_POOL_SIZE);
+    ~ProjectilePool() = default;
+
+    // adds a projectile, false if the pool is full
+    bool spawn(const float x, const float y, const float dx, const float dy, const float range,
+        const int damage, const int rAOE = 0);
+
+    // moves projectiles and queues the damage of what they hit
+    void update(const float delta, const SpatialGrid& zombies, const Quadtree& walls, DamageQueue& damageQueue);
+    void clear();
+
+    size_t size() const {return projectiles.size();}
+    const std::vector<Projectile>& getProjectiles() const {return projectiles;}
+
+private:
+    std::vector<Projectile> projectiles;
+    size_t capacity;
+    std::vector<char> expired; // set by the parallel step for every projectile to remove
+};
+
+#endif
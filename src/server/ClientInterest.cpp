@@ -0,0 +1,202 @@
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+#include "ClientInterest.h"
+#include "../game/GameManager.h"
+
+static bool inside(const float x, const float y, const SDL_Rect& area) {
+    return x >= area.x && x < area.x + area.w && y >= area.y && y < area.y + area.h;
+}
+
+static SDL_Rect grow(const SDL_Rect& rect, const int margin) {
+    return {rect.x - margin, rect.y - margin, rect.w + 2 * margin, rect.h + 2 * margin};
+}
+
+// index of the entity with id in snapshot, -1 when it is not there
+static int indexOf(const Snapshot& snapshot, const int32_t id) {
+    const auto it = std::lower_bound(snapshot.entities.begin(), snapshot.entities.end(), id,
+        [](const EntityState& e, const int32_t i) {return e.id < i;});
+    return it != snapshot.entities.end() && it->id == id ? it - snapshot.entities.begin() : -1;
+}
+
+ClientInterest::ClientInterest(const int viewW, const int viewH, const int budget) : camera(viewW, viewH),
+        budget(budget) {
+}
+
+/**
+ * Picks what fits the budget and encodes it. The size of each entity is estimated up front
+ * assuming small id gaps, so on the rare tick the encoding still comes out too large, the
+ * lowest ranked quarter of what was picked is put off and it is encoded again.
+ */
+void ClientInterest::update(const Snapshot& current, const uint32_t acked, const Entity& marine,
+        SnapshotCodec& codec, BitWriter& out) {
+    // the view of a tick SNAPSHOT_HISTORY old shares its slot with this one's
+    const Snapshot *baseline = acked != NO_TICK && current.tick - acked < SNAPSHOT_HISTORY
+        ? views.find(acked) : nullptr;
+
+    camera.move(marine.getX(), marine.getY());
+    gather(current, baseline, marine);
+    rank(current, baseline, marine.getId());
+
+    for (;;) {
+        build(current);
+        out.clear();
+        codec.encode(view, baseline, out);
+        if (out.bytes().size() <= static_cast<size_t>(budget)) {
+            break;
+        }
+
+        int drop = std::max(1, stats.sent / 4);
+        for (auto it = ranked.rbegin(); it != ranked.rend() && drop > 0; ++it) {
+            if ((*it)->send && (*it)->priority < FLT_MAX) {
+                (*it)->send = false;
+                --stats.sent;
+                --drop;
+            }
+        }
+        if (drop > 0) {
+            // only the client's own marine is left, it goes out over budget
+            break;
+        }
+    }
+
+    nextSent.clear();
+    for (const auto& c : candidates) {
+        nextSent.push_back({current.entities[c.index].id, c.send ? current.tick : c.since});
+    }
+    sent.swap(nextSent);
+
+    views.add(current.tick).entities.swap(view.entities);
+}
+
+/**
+ * Fills relevant with the index in current of every entity in the view plus INTEREST_MARGIN,
+ * zombies looked up through the quadtree filled at the start of the tick and the rest by
+ * testing the small managers, plus the entities the client has that are still within
+ * INTEREST_KEEP_MARGIN. The client's own marine is always relevant.
+ */
+void ClientInterest::gather(const Snapshot& current, const Snapshot *baseline, const Entity& marine) {
+    GameManager *gm = GameManager::instance();
+    const SDL_Rect area = grow(camera.getViewport(), INTEREST_MARGIN);
+    const SDL_Rect keep = grow(camera.getViewport(), INTEREST_KEEP_MARGIN);
+
+    relevant.clear();
+    const auto add = [&](const int32_t id) {
+        const int i = indexOf(current, id);
+        if (i >= 0) {
+            relevant.push_back(i);
+        }
+    };
+    const auto addInside = [&](const auto& manager) {
+        for (const auto& e : manager) {
+            if (inside(e.second.getX(), e.second.getY(), area)) {
+                add(e.first);
+            }
+        }
+    };
+
+    found.clear();
+    gm->getCollisionHandler().quadtreeZombie.retrieve(area, found);
+    for (const Entity *e : found) {
+        if (inside(e->getX(), e->getY(), area)) {
+            add(e->getId());
+        }
+    }
+
+    add(marine.getId());
+    addInside(gm->getMarineManager());
+    addInside(gm->getTurretManager());
+    addInside(gm->getBarricadeManager());
+    addInside(gm->getWeaponDropManager());
+
+    if (baseline != nullptr) {
+        for (const auto& e : baseline->entities) {
+            const int i = indexOf(current, e.id);
+            if (i >= 0 && inside(positionOf(current.entities[i].x), positionOf(current.entities[i].y), keep)) {
+                relevant.push_back(i);
+            }
+        }
+    }
+
+    // indexes in the snapshot are in id order already
+    std::sort(relevant.begin(), relevant.end());
+    relevant.erase(std::unique(relevant.begin(), relevant.end()), relevant.end());
+}
+
+/**
+ * Matches the relevant entities against the client's baseline, both in id order, and ranks
+ * the ones that changed by (ticks waiting + 1) / (distance from the view centre + bias). The
+ * best ones are marked to be sent for as long as the estimate of the encoding fits the budget,
+ * after the removals that are always sent.
+ */
+void ClientInterest::rank(const Snapshot& current, const Snapshot *baseline, const int32_t marineId) {
+    static const std::vector<EntityState> nothing;
+    const std::vector<EntityState>& base = baseline != nullptr ? baseline->entities : nothing;
+    const SDL_Rect v = camera.getViewport();
+    const float centreX = v.x + v.w / 2.0f;
+    const float centreY = v.y + v.h / 2.0f;
+
+    stats = {};
+    candidates.clear();
+    size_t b = 0;
+    size_t s = 0;
+
+    for (const uint32_t index : relevant) {
+        const EntityState& e = current.entities[index];
+        for (; b < base.size() && base[b].id < e.id; ++b) {
+            ++stats.removed;
+        }
+        const EntityState *previous = b < base.size() && base[b].id == e.id ? &base[b++] : nullptr;
+
+        while (s < sent.size() && sent[s].id < e.id) {
+            ++s;
+        }
+        const uint32_t since = s < sent.size() && sent[s].id == e.id ? sent[s].tick
+            : current.tick - NEW_ENTITY_STALENESS;
+
+        Candidate c = {index, previous, since, 0, 0, previous == nullptr || !sameState(e, *previous), false};
+        if (c.changed) {
+            const float distance = hypotf(positionOf(e.x) - centreX, positionOf(e.y) - centreY);
+            c.priority = e.id == marineId ? FLT_MAX
+                : (current.tick - since + 1) / (distance + PRIORITY_DISTANCE_BIAS);
+            c.bits = SnapshotCodec::entityBits(e, previous);
+            ++stats.changed;
+        }
+        candidates.push_back(c);
+    }
+    stats.removed += base.size() - b;
+    stats.considered = candidates.size();
+
+    ranked.clear();
+    for (auto& c : candidates) {
+        if (c.changed) {
+            ranked.push_back(&c);
+        }
+    }
+    std::sort(ranked.begin(), ranked.end(), [](const Candidate *a, const Candidate *b) {
+        return a->priority > b->priority;
+    });
+
+    int left = budget * 8 - SnapshotCodec::HEADER_BITS - stats.removed * SnapshotCodec::REMOVED_BITS;
+    for (Candidate *c : ranked) {
+        if (c->bits <= left || c->priority == FLT_MAX) {
+            c->send = true;
+            left -= c->bits;
+            ++stats.sent;
+        }
+    }
+}
+
+// the client's view after this tick, what was sent and what it keeps from its baseline
+void ClientInterest::build(const Snapshot& current) {
+    view.tick = current.tick;
+    view.entities.clear();
+    for (const auto& c : candidates) {
+        if (c.send) {
+            view.entities.push_back(current.entities[c.index]);
+        } else if (c.previous != nullptr) {
+            view.entities.push_back(*c.previous);
+        }
+    }
+}
@@ -0,0 +1,92 @@
+#ifndef CLIENTINTEREST_H
+#define CLIENTINTEREST_H
+
+#include <SDL2/SDL.h>
+#include <cstdint>
+#include <vector>
+
+#include "../basic/Entity.h"
+#include "../net/BitStream.h"
+#include "../net/NetProtocol.h"
+#include "../net/Snapshot.h"
+#include "../view/Camera.h"
+
+// how far past a client's view an entity becomes relevant to it, covers a sprite and a few ticks of latency
+static constexpr int INTEREST_MARGIN = 256;
+// entities the client already has are kept until they are this far past its view, so ones
+// walking along the edge of the margin are not removed and sent again over and over
+static constexpr int INTEREST_KEEP_MARGIN = 512;
+// bytes of snapshot a client is sent per tick, one STATE packet
+static constexpr int SNAPSHOT_BUDGET = STATE_PAYLOAD_SIZE;
+// added to an entity's distance from the view centre when prioritising, keeps the ones at the
+// centre from drowning out every other entity
+static constexpr float PRIORITY_DISTANCE_BIAS = 64;
+// ticks an entity that just became relevant counts as waiting already, ahead of ones barely changed
+static constexpr uint32_t NEW_ENTITY_STALENESS = 8;
+
+// entities handled by the last update
+struct InterestStats {
+    int considered; // relevant to the client, in its view plus margin or still kept
+    int changed; // considered and different from what the client has
+    int sent; // changed and fitted into the budget, the rest wait for a later tick
+    int removed; // the client had them but they died or left its view
+};
+
+/*
+ * What one client is sent, its relevancy set.
+ * Every tick the entities around the client's marine are gathered through the zombie quadtree
+ * and the small managers, within its camera viewport plus INTEREST_MARGIN. The ones that differ
+ * from what the client has are ranked by how long they have waited over how far they are from
+ * the view centre, and the best are sent as long as the snapshot fits the byte budget. Its own
+ * marine always comes first. Entities not sent keep the state the client has, so they are
+ * only ever late, never wrong, and climb the ranking until they are sent.
+ * The client's view after every tick is kept, deltas are encoded from the one it acknowledged.
+ */
+class ClientInterest {
+public:
+    ClientInterest(const int viewW, const int viewH, const int budget);
+    ~ClientInterest() = default;
+
+    // encodes into out the client's view of current, as a delta from the view of tick acked
+    void update(const Snapshot& current, const uint32_t acked, const Entity& marine, SnapshotCodec& codec,
+        BitWriter& out);
+
+    const InterestStats& getStats() const {return stats;}
+
+private:
+    // a relevant entity, in id order
+    struct Candidate {
+        uint32_t index; // in the current snapshot
+        const EntityState *previous; // what the client has, nullptr if it has nothing
+        uint32_t since; // tick it was last sent
+        float priority;
+        int bits;
+        bool changed;
+        bool send;
+    };
+
+    // tick an entity was last sent to the client, for the entities of the last update in id order
+    struct Sent {
+        int32_t id;
+        uint32_t tick;
+    };
+
+    Camera camera;
+    int budget;
+    SnapshotHistory views; // what the client has after each tick's snapshot
+    Snapshot view; // being built
+
+    std::vector<Entity *> found;
+    std::vector<uint32_t> relevant;
+    std::vector<Candidate> candidates;
+    std::vector<Candidate *> ranked;
+    std::vector<Sent> sent;
+    std::vector<Sent> nextSent;
+    InterestStats stats = {};
+
+    void gather(const Snapshot& current, const Snapshot *baseline, const Entity& marine);
+    void rank(const Snapshot& current, const Snapshot *baseline, const int32_t marineId);
+    void build(const Snapshot& current);
+};
+
+#endif
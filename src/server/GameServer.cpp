@@ -0,0 +1,377 @@
+#include <time.h>
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <thread>
+
+#include "GameServer.h"
+#include "../game/GameManager.h"
+#include "../log/log.h"
+#include "../view/Window.h"
+
+using ServerClock = std::chrono::steady_clock;
+
+// seed of the zombies spawned at start, the same layout every run
+static constexpr unsigned int SERVER_SEED = 4981;
+
+// µs of CPU the calling thread has used, the other threads of the process are not counted
+static double threadCpuUs() {
+    timespec t;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &t);
+    return t.tv_sec * 1e6 + t.tv_nsec / 1e3;
+}
+
+GameServer::GameServer(const int maxClients, const int tickRate, const int budget) : clients(maxClients),
+        tickRate(tickRate), delta(1.0f / tickRate), budget(budget) {
+}
+
+GameServer::~GameServer() {
+    socket.close();
+}
+
+int GameServer::getClientCount() const {
+    int count = 0;
+    for (const auto& c : clients) {
+        count += c.connected;
+    }
+    return count;
+}
+
+/**
+ * Binds the port and builds the same level the match loads, plus zombies spread over the map.
+ */
+bool GameServer::start(const uint16_t port, const int zombies) {
+    if (!socket.open(port)) {
+        return false;
+    }
+
+    GameManager::instance()->setBoundary(0, 0, MAP_WIDTH, MAP_HEIGHT);
+    GameManager::instance()->addObject(base);
+
+    std::mt19937 rng(SERVER_SEED);
+    std::uniform_real_distribution<float> x(0, MAP_WIDTH - ZOMBIE_WIDTH);
+    std::uniform_real_distribution<float> y(0, MAP_HEIGHT - ZOMBIE_HEIGHT);
+    for (int i = 0; i < zombies; ++i) {
+        GameManager::instance()->createZombie(x(rng), y(rng));
+    }
+
+    logv("Server listening on port %u, %zu clients at %d ticks per second\n", socket.getPort(), clients.size(),
+        tickRate);
+    return true;
+}
+
+/**
+ * Fixed rate loop. Every tick handles the datagrams that arrived, steps the simulation by
+ * exactly 1 / tickRate seconds and broadcasts the result, then sleeps until the next tick is
+ * due. A tick that starts late is counted as an overrun, and the schedule restarts from now
+ * when the server falls more than a second behind instead of running a burst of ticks.
+ */
+void GameServer::run(const int seconds, FILE *out) {
+    const auto period = std::chrono::duration_cast<ServerClock::duration>(std::chrono::duration<double>(delta));
+    const auto started = ServerClock::now();
+    auto due = started;
+    uint32_t lastWave = 0;
+    uint32_t lastReport = 0;
+
+    running = true;
+    while (running) {
+        const auto tickStart = ServerClock::now();
+        if (tickStart - due > period) {
+            ++stats.overruns;
+            if (tickStart - due > std::chrono::seconds(1)) {
+                due = tickStart;
+            }
+        }
+        now = std::chrono::duration_cast<std::chrono::milliseconds>(tickStart - started).count();
+
+        double cpu = threadCpuUs();
+        receive();
+        double networkUs = threadCpuUs() - cpu;
+
+        cpu = threadCpuUs();
+        step();
+        stats.simulateUs += threadCpuUs() - cpu;
+
+        cpu = threadCpuUs();
+        broadcast();
+        networkUs += threadCpuUs() - cpu;
+        stats.networkUs += networkUs;
+
+        ++stats.ticks;
+        stats.clientTicks += getClientCount();
+
+        if (now - lastWave >= SERVER_WAVE_MS) {
+            GameManager::instance()->createZombieWave(1);
+            lastWave = now;
+        }
+        if (now - lastReport >= SERVER_REPORT_MS) {
+            report(out);
+            lastReport = now;
+        }
+        if (seconds > 0 && now >= static_cast<uint32_t>(seconds) * 1000) {
+            break;
+        }
+
+        due += period;
+        std::this_thread::sleep_until(due);
+    }
+
+    for (size_t i = 0; i < clients.size(); ++i) {
+        if (clients[i].connected) {
+            leave(i);
+        }
+    }
+    running = false;
+}
+
+/**
+ * Drains the socket. HELLO from a new address takes a free slot, INPUT queues the commands
+ * the sender's marine has not had yet, ACK moves its baseline up to the snapshot it received and BYE frees its slot. Datagrams from addresses that did not join are ignored, and
+ * clients silent for CLIENT_TIMEOUT_MS are dropped.
+ */
+void GameServer::receive() {
+    NetAddress from;
+    size_t size;
+
+    while ((size = socket.receive(buffer, sizeof(buffer), from)) > 0) {
+        PacketReader reader(buffer, size);
+        const PacketType type = static_cast<PacketType>(reader.getU8());
+
+        if (type == PacketType::HELLO) {
+            join(from, reader);
+            continue;
+        }
+
+        int slot = -1;
+        for (size_t i = 0; i < clients.size(); ++i) {
+            if (clients[i].connected && clients[i].address == from) {
+                slot = i;
+                break;
+            }
+        }
+        if (slot < 0) {
+            continue;
+        }
+        clients[slot].lastHeard = now;
+
+        switch (type) {
+            case PacketType::INPUT: {
+                ClientSlot& client = clients[slot];
+                const int count = reader.getU8();
+                for (int i = 0; i < count; ++i) {
+                    const InputCommand command = readCommand(reader);
+                    if (!reader.ok()) {
+                        break;
+                    }
+                    if (command.sequence > client.received && client.commands.size() < PREDICTION_BUFFER) {
+                        client.commands.push_back(command);
+                        client.received = command.sequence;
+                    }
+                }
+                break;
+            }
+            case PacketType::ACK: {
+                const uint32_t acked = reader.getU32();
+                ClientSlot& client = clients[slot];
+                if (reader.ok() && acked <= tick && (client.acked == NO_TICK || acked > client.acked)) {
+                    client.acked = acked;
+                }
+                break;
+            }
+            case PacketType::BYE:
+                leave(slot);
+                break;
+            default:
+                break;
+        }
+    }
+
+    for (size_t i = 0; i < clients.size(); ++i) {
+        if (clients[i].connected && now - clients[i].lastHeard > CLIENT_TIMEOUT_MS) {
+            logv("Client %zu timed out\n", i);
+            leave(i);
+        }
+    }
+}
+
+/**
+ * Gives the client a slot and a marine at the base's spawn point and welcomes it. A client
+ * whose WELCOME was lost says HELLO again and is welcomed again to the same slot.
+ * HELLO carries the size of the client's view, which sets what is relevant to it.
+ */
+void GameServer::join(const NetAddress& from, PacketReader& hello) {
+    int slot = -1;
+    for (size_t i = 0; i < clients.size(); ++i) {
+        if (clients[i].connected && clients[i].address == from) {
+            slot = i;
+            break;
+        }
+        if (!clients[i].connected && slot < 0) {
+            slot = i;
+        }
+    }
+
+    packet.clear();
+    if (slot < 0) {
+        packet.putU8(static_cast<uint8_t>(PacketType::FULL));
+        socket.send(from, packet.getData(), packet.size());
+        return;
+    }
+
+    ClientSlot& client = clients[slot];
+    if (!client.connected) {
+        int viewW = hello.getU16();
+        int viewH = hello.getU16();
+        if (!hello.ok() || viewW == 0 || viewH == 0) {
+            viewW = SCREEN_WIDTH;
+            viewH = SCREEN_HEIGHT;
+        }
+
+        const Point spawn = base.getSpawnPoint();
+        client.connected = true;
+        client.address = from;
+        client.marineId = GameManager::instance()->createMarine();
+        client.acked = NO_TICK;
+        client.interest.reset(new ClientInterest(viewW, viewH, budget));
+        GameManager::instance()->getMarine(client.marineId).setPosition(spawn.first, spawn.second);
+        logv("Client %d joined with marine %d\n", slot, client.marineId);
+    }
+    client.lastHeard = now;
+
+    packet.putU8(static_cast<uint8_t>(PacketType::WELCOME));
+    packet.putU8(slot);
+    packet.putI32(client.marineId);
+    packet.putU16(tickRate);
+    send(client);
+}
+
+// removes the client's marine and tells it, in case it is still listening
+void GameServer::leave(const int slot) {
+    ClientSlot& client = clients[slot];
+
+    packet.clear();
+    packet.putU8(static_cast<uint8_t>(PacketType::BYE));
+    send(client);
+
+    GameManager::instance()->deleteMarine(client.marineId);
+    logv("Client %d left\n", slot);
+    client = ClientSlot();
+}
+
+/**
+ * Applies each client's queued commands in order, through the same applyCommand its own
+ * prediction runs, for as long as its credit lasts. Every tick adds a tick's worth of credit,
+ * commands that arrive late are caught up within INPUT_CREDIT_MS and the rest wait. Marines
+ * keep no velocity of their own here, updateMarines leaves them where their commands put them.
+ */
+void GameServer::applyInput() {
+    for (auto& client : clients) {
+        if (!client.connected) {
+            continue;
+        }
+        client.inputCredit = std::min(client.inputCredit + delta * 1000, INPUT_CREDIT_MS);
+
+        Marine& marine = GameManager::instance()->getMarine(client.marineId);
+        while (!client.commands.empty() && client.commands.front().ms <= client.inputCredit) {
+            const InputCommand& command = client.commands.front();
+            applyCommand(marine, command, GameManager::instance()->getCollisionHandler());
+            client.inputCredit -= command.ms;
+            client.inputSequence = command.sequence;
+            client.commands.pop_front();
+        }
+    }
+}
+
+// the update sequence of GameStateMatch::update, animations aside since nothing is drawn here
+void GameServer::step() {
+    GameManager::instance()->updateCollider();
+    applyInput();
+    GameManager::instance()->updateMarines(delta);
+    GameManager::instance()->updateZombies(delta);
+    GameManager::instance()->updateTurrets(delta);
+    GameManager::instance()->updateProjectiles(delta);
+    GameManager::instance()->applyDamage();
+    GameManager::instance()->despawnDead(delta);
+    ++tick;
+}
+
+/**
+ * Captures the tick once, then encodes for every client the part of it relevant to that
+ * client, as a delta from the view it last acknowledged.
+ */
+void GameServer::broadcast() {
+    captureSnapshot(tick, current);
+
+    for (const auto& client : clients) {
+        if (!client.connected) {
+            continue;
+        }
+        client.interest->update(current, client.acked, GameManager::instance()->getMarine(client.marineId), codec,
+            encoded);
+        sendSnapshot(client);
+
+        const InterestStats& interest = client.interest->getStats();
+        stats.considered += interest.considered;
+        stats.changed += interest.changed;
+        stats.sent += interest.sent;
+        stats.removed += interest.removed;
+    }
+}
+
+// splits the encoded snapshot into as many STATE packets as it takes
+void GameServer::sendSnapshot(const ClientSlot& client) {
+    const std::vector<uint8_t>& bytes = encoded.bytes();
+    const size_t parts = std::max<size_t>(1, (bytes.size() + STATE_PAYLOAD_SIZE - 1) / STATE_PAYLOAD_SIZE);
+    if (parts > MAX_STATE_PARTS) {
+        logv("Snapshot of tick %u is %zu bytes, too large to send\n", tick, bytes.size());
+        return;
+    }
+
+    for (size_t part = 0; part < parts; ++part) {
+        const size_t first = part * STATE_PAYLOAD_SIZE;
+        const size_t count = std::min(STATE_PAYLOAD_SIZE, bytes.size() - first);
+
+        packet.clear();
+        packet.putU8(static_cast<uint8_t>(PacketType::STATE));
+        packet.putU32(tick);
+        packet.putU32(client.inputSequence);
+        packet.putU16(part);
+        packet.putU16(parts);
+        packet.putBytes(bytes.data() + first, count);
+        send(client);
+    }
+}
+
+void GameServer::send(const ClientSlot& client) {
+    if (socket.send(client.address, packet.getData(), packet.size())) {
+        stats.bytesSent += packet.size();
+        ++stats.packetsSent;
+    }
+}
+
+/**
+ * Writes the averages since the last report as one JSON line and starts over. Per client
+ * figures divide the network cost by the clients connected on average, the simulation cost
+ * does not depend on them beyond their marines.
+ */
+void GameServer::report(FILE *out) {
+    if (stats.ticks == 0) {
+        return;
+    }
+
+    const double ticks = stats.ticks;
+    const double clientsPerTick = stats.clientTicks / ticks;
+    const double perClient = clientsPerTick > 0 ? 1 / clientsPerTick : 0;
+
+    fprintf(out, "{\"tick\": %u, \"clients\": %.1f, \"entities\": %zu, \"overruns\": %u, "
+        "\"simulate_us\": %.1f, \"network_us\": %.1f, \"network_us_per_client\": %.1f, "
+        "\"bytes_per_client\": %.0f, \"packets_per_client\": %.1f, \"considered_per_client\": %.1f, "
+        "\"changed_per_client\": %.1f, \"sent_per_client\": %.1f, \"removed_per_client\": %.1f}\n",
+        tick, clientsPerTick, current.entities.size(), stats.overruns, stats.simulateUs / ticks,
+        stats.networkUs / ticks, stats.networkUs / ticks * perClient, stats.bytesSent / ticks * perClient,
+        stats.packetsSent / ticks * perClient, stats.considered / ticks * perClient,
+        stats.changed / ticks * perClient, stats.sent / ticks * perClient, stats.removed / ticks * perClient);
+    fflush(out);
+
+    stats = {};
+}
@@ -0,0 +1,107 @@
+#ifndef GAMESERVER_H
+#define GAMESERVER_H
+
+#include <stdio.h>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <vector>
+
+#include "../buildings/Base.h"
+#include "../net/BitStream.h"
+#include "../net/MarinePredictor.h"
+#include "../net/NetProtocol.h"
+#include "../net/Snapshot.h"
+#include "../net/UdpSocket.h"
+#include "ClientInterest.h"
+
+static constexpr uint32_t SERVER_WAVE_MS = 5000; // between zombie waves, like the match
+static constexpr uint32_t SERVER_REPORT_MS = 1000; // of ticks averaged into each report line
+// ms of input a client may bank while its commands are late, so a burst after a stall is caught up
+// but a client can not move its marine faster than time passes
+static constexpr float INPUT_CREDIT_MS = 250;
+
+// a client that joined, identified by the address its datagrams come from
+struct ClientSlot {
+    bool connected = false;
+    NetAddress address = {0, 0};
+    int32_t marineId = -1;
+    uint32_t lastHeard = 0; // server ms of its last datagram
+    uint32_t acked = NO_TICK; // newest snapshot it received in full, its next one is a delta from it
+    std::unique_ptr<ClientInterest> interest; // what it is sent
+    std::deque<InputCommand> commands; // received, not applied yet, in sequence order
+    uint32_t received = 0; // newest command sequence queued
+    uint32_t inputSequence = 0; // newest command applied, echoed with every snapshot
+    float inputCredit = 0; // ms of commands it may still apply
+};
+
+// costs of the server thread summed over the ticks since the last report
+struct ServerStats {
+    uint32_t ticks;
+    uint32_t overruns; // ticks that started late because the previous one ran long
+    double simulateUs; // thread CPU stepping the GameManager
+    double networkUs; // thread CPU receiving input, capturing and broadcasting the snapshot
+    uint64_t bytesSent;
+    uint64_t packetsSent;
+    uint64_t clientTicks; // sum of the clients connected at each tick
+    uint64_t considered; // entities relevant to a client, summed over clients and ticks
+    uint64_t changed;
+    uint64_t sent;
+    uint64_t removed;
+};
+
+/*
+ * Headless authoritative server.
+ * Steps the GameManager at a fixed tick rate with the same update sequence as the match,
+ * applies the input clients send for their marines and sends each of them a snapshot of
+ * the entities around its marine after every tick, within its byte budget and delta
+ * compressed against the last one that client acknowledged. Nothing here touches the window
+ * or the renderer.
+ * Every SERVER_REPORT_MS a JSON line reports the thread CPU per tick spent simulating
+ * and networking, what that costs per connected client and how many of the entities
+ * relevant to a client it was sent.
+ */
+class GameServer {
+public:
+    GameServer(const int maxClients, const int tickRate, const int budget);
+    ~GameServer();
+
+    bool start(const uint16_t port, const int zombies); // opens the socket and sets the level up, returns success
+    void run(const int seconds, FILE *out); // ticks until stop(), or for seconds when not 0
+    void stop() {running = false;} // safe from a signal handler or another thread
+
+    int getClientCount() const;
+
+private:
+    UdpSocket socket;
+    std::vector<ClientSlot> clients; // one slot per client allowed, indexed by client id
+    Base base;
+    std::atomic<bool> running{false};
+
+    int tickRate;
+    float delta; // seconds simulated per tick
+    int budget; // bytes of snapshot per client per tick
+    uint32_t tick = 0;
+    uint32_t now = 0; // ms since start of the tick being run
+
+    Snapshot current; // every entity at the end of this tick
+    SnapshotCodec codec;
+    BitWriter encoded;
+    PacketWriter packet;
+    uint8_t buffer[MAX_PACKET_SIZE];
+
+    ServerStats stats = {};
+
+    void receive(); // handles every datagram queued since the last tick
+    void join(const NetAddress& from, PacketReader& hello);
+    void leave(const int slot);
+    void applyInput(); // each client's commands that fit its credit
+    void step(); // one tick of the simulation
+    void broadcast(); // sends this tick's snapshot to every client
+    void sendSnapshot(const ClientSlot& client); // sends what was encoded for the client
+    void send(const ClientSlot& client); // sends the packet being built to a client
+    void report(FILE *out);
+};
+
+#endif
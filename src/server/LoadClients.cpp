@@ -0,0 +1,165 @@
+#include <algorithm>
+#include <chrono>
+#include <random>
+
+#include "LoadClients.h"
+#include "../game/GameManager.h"
+#include "../net/NetProtocol.h"
+#include "../view/Window.h"
+
+LoadClients::~LoadClients() {
+    stop();
+}
+
+void LoadClients::start(const int count, const uint16_t serverPort, const int tickRate) {
+    stop();
+    clients.clear();
+    for (int i = 0; i < count; ++i) {
+        clients.emplace_back();
+        clients.back().socket.reset(new UdpSocket());
+        if (!clients.back().socket->open(0)) {
+            clients.pop_back();
+            continue;
+        }
+        // made here, a marine's inventory registers its gun with the GameManager
+        const SDL_Rect size = {initVal, initVal, defaultSize, defaultSize};
+        clients.back().marine.reset(new Marine(-1, size, size, size, size));
+    }
+
+    running = true;
+    thread = std::thread(&LoadClients::run, this, loopbackAddress(serverPort), tickRate);
+}
+
+void LoadClients::stop() {
+    running = false;
+    if (thread.joinable()) {
+        thread.join();
+    }
+}
+
+/**
+ * Clients not welcomed yet keep saying HELLO every tick, so a lost datagram or a server
+ * started late only delays them.
+ */
+void LoadClients::run(const NetAddress server, const int tickRate) {
+    const auto period = std::chrono::microseconds(1000000 / tickRate);
+    const float delta = 1.0f / tickRate;
+    const auto started = std::chrono::steady_clock::now();
+    auto due = started;
+    uint32_t lastTurn = 0;
+    std::mt19937 rng(clients.size());
+    std::uniform_int_distribution<int> direction(-1, 1);
+    PacketWriter packet;
+    uint8_t buffer[MAX_PACKET_SIZE];
+
+    while (running) {
+        const uint32_t now = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - started).count();
+        const bool turn = now - lastTurn >= LOAD_TURN_MS;
+        if (turn) {
+            lastTurn = now;
+        }
+
+        for (auto& c : clients) {
+            NetAddress from;
+            size_t size;
+            while ((size = c.socket->receive(buffer, sizeof(buffer), from)) > 0) {
+                receive(c, server, buffer, size);
+            }
+
+            packet.clear();
+            if (!c.welcomed) {
+                packet.putU8(static_cast<uint8_t>(PacketType::HELLO));
+                packet.putU16(SCREEN_WIDTH);
+                packet.putU16(SCREEN_HEIGHT);
+            } else {
+                if (turn) {
+                    c.moveX = direction(rng);
+                    c.moveY = direction(rng);
+                }
+                c.predictor.predict(*c.marine, c.moveX, c.moveY, 0, delta, world);
+                c.predictor.writeInput(packet);
+            }
+            c.socket->send(server, packet.getData(), packet.size());
+        }
+
+        due += period;
+        std::this_thread::sleep_until(due);
+    }
+
+    packet.clear();
+    packet.putU8(static_cast<uint8_t>(PacketType::BYE));
+    for (auto& c : clients) {
+        if (c.welcomed) {
+            c.socket->send(server, packet.getData(), packet.size());
+        }
+    }
+}
+
+/**
+ * Decodes a completed snapshot against the baseline the server chose, acknowledges it and
+ * reconciles the predicted marine with the server's.
+ * One whose baseline is no longer held is dropped unacknowledged, the server falls back to
+ * a full snapshot once the last acknowledged one leaves its history.
+ */
+void LoadClients::receive(Client& client, const NetAddress server, const uint8_t *datagram, const size_t size) {
+    bytesReceived += size;
+    switch (static_cast<PacketType>(datagram[0])) {
+        case PacketType::WELCOME: {
+            PacketReader welcome(datagram, size);
+            welcome.getU8();
+            welcome.getU8();
+            const int32_t marineId = welcome.getI32();
+            if (welcome.ok()) {
+                client.welcomed = true;
+                client.marineId = marineId;
+            }
+            break;
+        }
+        case PacketType::STATE: {
+            if (!client.assembler.add(datagram, size)) {
+                break;
+            }
+            BitReader in(client.assembler.getData(), client.assembler.getSize());
+            uint32_t tick;
+            uint32_t baselineTick;
+            if (!SnapshotCodec::readHeader(in, tick, baselineTick)) {
+                break;
+            }
+            const Snapshot *baseline = client.received.find(baselineTick);
+            if (baselineTick != NO_TICK && baseline == nullptr) {
+                break;
+            }
+            // decoding into the baseline's own slot would overwrite it while reading it
+            if (tick % SNAPSHOT_HISTORY == baselineTick % SNAPSHOT_HISTORY) {
+                break;
+            }
+            Snapshot& snapshot = client.received.add(tick);
+            if (!codec.decode(in, baseline, snapshot)) {
+                break;
+            }
+            ++snapshotsDecoded;
+
+            PacketWriter ack;
+            ack.putU8(static_cast<uint8_t>(PacketType::ACK));
+            ack.putU32(tick);
+            client.socket->send(server, ack.getData(), ack.size());
+
+            const auto own = std::lower_bound(snapshot.entities.begin(), snapshot.entities.end(), client.marineId,
+                [](const EntityState& e, const int32_t id) {return e.id < id;});
+            if (own != snapshot.entities.end() && own->id == client.marineId) {
+                // the first one only moves the marine from nowhere to its spawn point
+                const bool first = client.predictor.getAcked() == 0;
+                replayed += client.predictor.reconcile(*client.marine, *own, client.assembler.getInputSequence(),
+                    world);
+                if (!first) {
+                    ++reconciled;
+                    correction = correction + client.predictor.getCorrection();
+                }
+            }
+            break;
+        }
+        default:
+            break;
+    }
+}
@@ -0,0 +1,71 @@
+#ifndef LOADCLIENTS_H
+#define LOADCLIENTS_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "../collision/CollisionHandler.h"
+#include "../net/MarinePredictor.h"
+#include "../net/Snapshot.h"
+#include "../net/SnapshotAssembler.h"
+#include "../net/UdpSocket.h"
+#include "../player/Marine.h"
+
+static constexpr uint32_t LOAD_TURN_MS = 1000; // a load client changes direction this often
+
+/*
+ * Stand-in clients to load the server with, run on a thread of their own so their cost
+ * stays out of the server thread's CPU time.
+ * Each one joins over loopback, sends input at the tick rate, walking a random direction it
+ * changes every LOAD_TURN_MS, and decodes and acknowledges every snapshot it receives
+ * in full, like a game client would.
+ * Each also predicts its marine and reconciles it with every snapshot. They have no level of
+ * their own, their marines walk an empty world, so the correction whenever the server's marine
+ * bumps into something shows reconciliation pulling the prediction back.
+ */
+class LoadClients {
+public:
+    LoadClients() = default;
+    ~LoadClients();
+
+    void start(const int count, const uint16_t serverPort, const int tickRate);
+    void stop();
+
+    uint64_t getBytesReceived() const {return bytesReceived;}
+    uint64_t getSnapshotsDecoded() const {return snapshotsDecoded;}
+    uint64_t getReconciled() const {return reconciled;}
+    uint64_t getReplayed() const {return replayed;} // commands replayed over every reconcile
+    double getCorrection() const {return correction;} // pixels moved by every reconcile
+
+private:
+    struct Client {
+        std::unique_ptr<UdpSocket> socket;
+        bool welcomed = false;
+        int32_t marineId = -1;
+        std::unique_ptr<Marine> marine; // predicted
+        MarinePredictor predictor;
+        int moveX = 0;
+        int moveY = 0;
+        SnapshotAssembler assembler;
+        SnapshotHistory received;
+    };
+
+    std::vector<Client> clients;
+    std::thread thread;
+    std::atomic<bool> running{false};
+    std::atomic<uint64_t> bytesReceived{0};
+    std::atomic<uint64_t> snapshotsDecoded{0};
+    std::atomic<uint64_t> reconciled{0};
+    std::atomic<uint64_t> replayed{0};
+    std::atomic<double> correction{0};
+    SnapshotCodec codec;
+    CollisionHandler world; // empty
+
+    void run(const NetAddress server, const int tickRate);
+    void receive(Client& client, const NetAddress server, const uint8_t *datagram, const size_t size);
+};
+
+#endif
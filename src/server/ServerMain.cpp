@@ -0,0 +1,120 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <getopt.h>
+#include <signal.h>
+#include <algorithm>
+#include <SDL2/SDL.h>
+
+#include "GameServer.h"
+#include "LoadClients.h"
+#include "../log/log.h"
+
+static GameServer *server = nullptr;
+
+// ctrl-c ends the tick loop, the clients are told and the report is flushed
+static void interrupt(int) {
+    if (server != nullptr) {
+        server->stop();
+    }
+}
+
+/*
+ * Entry point of the server target, no window, renderer or audio is ever opened.
+ * Usage: bin/server [-p port] [-c clients] [-t ticks] [-z zombies] [-l clients] [-d seconds] [-b bytes] [-o file] [-v]
+ *   -p  UDP port to listen on, loopback only
+ *   -c  clients allowed at once
+ *   -t  ticks per second
+ *   -z  zombies spread over the map at start
+ *   -l  load clients to run alongside the server, at most -c of them are let in
+ *   -d  stop after seconds, runs until interrupted otherwise
+ *   -b  bytes of snapshot each client is sent per tick
+ *   -o  write the per second reports to file instead of stdout
+ */
+int main(int argc, char *argv[]) {
+    uint16_t port = SERVER_PORT;
+    int maxClients = MAX_CLIENTS;
+    int tickRate = SERVER_TICK_RATE;
+    int zombies = 0;
+    int loadClients = 0;
+    int seconds = 0;
+    int budget = SNAPSHOT_BUDGET;
+    FILE *out = stdout;
+    int opt;
+
+    log_verbose = 0;
+    while ((opt = getopt(argc, argv, "p:c:t:z:l:d:b:o:v")) != -1) {
+        switch (opt) {
+            case 'p':
+                port = atoi(optarg);
+                break;
+            case 'c':
+                maxClients = std::max(1, atoi(optarg));
+                break;
+            case 't':
+                tickRate = std::max(1, atoi(optarg));
+                break;
+            case 'z':
+                zombies = atoi(optarg);
+                break;
+            case 'l':
+                loadClients = atoi(optarg);
+                break;
+            case 'd':
+                seconds = atoi(optarg);
+                break;
+            case 'b':
+                budget = std::max(64, atoi(optarg));
+                break;
+            case 'o':
+                if ((out = fopen(optarg, "w")) == nullptr) {
+                    perror("fopen");
+                    return 1;
+                }
+                break;
+            case 'v':
+                log_verbose = 2;
+                break;
+            case '?':
+                printf("-p port\n-c clients\n-t ticks per second\n-z zombies\n-l load clients\n-d seconds\n"
+                    "-b bytes per client per tick\n-o output file\n-v verbose\n");
+                return 1;
+        }
+    }
+
+    // only the timer, SDL_GetTicks drives the turret scans
+    if (SDL_Init(SDL_INIT_TIMER) < 0) {
+        loge("SDL could not initialize! SDL Error: %s\n", SDL_GetError());
+        return 1;
+    }
+
+    GameServer game(maxClients, tickRate, budget);
+    if (!game.start(port, zombies)) {
+        SDL_Quit();
+        return 1;
+    }
+    server = &game;
+    signal(SIGINT, interrupt);
+    signal(SIGTERM, interrupt);
+
+    LoadClients load;
+    if (loadClients > 0) {
+        load.start(loadClients, port, tickRate);
+    }
+
+    game.run(seconds, out);
+    load.stop();
+    if (loadClients > 0) {
+        const double reconciled = std::max<uint64_t>(1, load.getReconciled());
+        fprintf(out, "{\"load_clients\": %d, \"snapshots_decoded\": %lu, \"bytes_received\": %lu, "
+            "\"replayed_per_reconcile\": %.1f, \"correction_per_reconcile\": %.2f}\n", loadClients,
+            static_cast<unsigned long>(load.getSnapshotsDecoded()), static_cast<unsigned long>(load.getBytesReceived()),
+            load.getReplayed() / reconciled, load.getCorrection() / reconciled);
+    }
+
+    server = nullptr;
+    if (out != stdout) {
+        fclose(out);
+    }
+    SDL_Quit();
+    return 0;
+}
@@ -0,0 +1,36 @@
+#include "Animation.h"
+
+std::vector<Animations::Animation> Animations::animations;
+std::vector<SDL_Rect> Animations::frames;
+uint32_t Animations::clock = 0;
+int32_t Animations::phaseOrigin = 0;
+const bool Animations::built = Animations::build();
+
+/**
+ * Lays the clips of every sheet, action and direction out one animation after the other,
+ * in the order select() numbers them.
+ */
+bool Animations::build() {
+    for (const auto& sheet : SHEET_LAYOUTS) {
+        for (int action = 0; action < ANIMATION_ACTIONS; ++action) {
+            const ActionFrames& played = sheet.actions[action];
+            const bool death = action == static_cast<int>(AnimationAction::DIE) && sheet.death.w > 0;
+
+            for (int row = 0; row < ANIMATION_DIRECTIONS; ++row) {
+                animations.push_back({sheet.texture, static_cast<uint16_t>(frames.size()), 0,
+                    static_cast<uint16_t>(played.msPerFrame), static_cast<uint16_t>(sheet.cellW),
+                    static_cast<uint16_t>(sheet.cellH)});
+                if (death) {
+                    frames.push_back(sheet.death);
+                    animations.back().count = 1;
+                    continue;
+                }
+                for (const int column : played.columns) {
+                    frames.push_back({column * sheet.cellW, row * sheet.cellH, sheet.cellW, sheet.cellH});
+                }
+                animations.back().count = played.columns.size();
+            }
+        }
+    }
+    return true;
+}
@@ -0,0 +1,147 @@
+#ifndef ANIMATION_H
+#define ANIMATION_H
+
+#include <SDL2/SDL.h>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "SpriteTypes.h"
+
+static constexpr int ANIMATION_DIRECTIONS = 8; // rows of a character sheet
+static constexpr int ANIMATION_PHASE_MS = 37; // clock offset between consecutive entity ids, keeps crowds out of step
+static constexpr uint16_t NO_ANIMATION = UINT16_MAX; // entity drawn with its whole sprite
+
+// rows of a character sprite sheet, in the order they are drawn (see SpriteTypes.h)
+enum class SheetRow : int {
+    FRONT,
+    FRONT_LEFT,
+    LEFT,
+    BACK_RIGHT,
+    BACK,
+    BACK_LEFT,
+    RIGHT,
+    FRONT_RIGHT
+};
+
+// what the character is doing, selects the frames played in its direction's row
+enum class AnimationAction : int {
+    IDLE,
+    WALK,
+    ATTACK,
+    DIE
+};
+static constexpr int ANIMATION_ACTIONS = 4;
+
+// character sprite sheets, indexes SHEET_LAYOUTS
+enum class AnimationSheet : int {
+    BABY_ZOMBIE,
+    DIGGER_ZOMBIE,
+    BOSS_ZOMBIE,
+    MARINE
+};
+
+// columns of a row played in order, every msPerFrame, looping
+struct ActionFrames {
+    std::vector<int> columns;
+    int msPerFrame;
+};
+
+/*
+ * A character sheet: a grid of cellW x cellH frames with one row per SheetRow and the
+ * columns idle, step left, step right, damaged and attack. The death frame is drawn in
+ * every direction, it is left empty on sheets without one and DIE shows idle instead.
+ */
+struct SheetLayout {
+    TEXTURES texture;
+    int cellW;
+    int cellH;
+    std::array<ActionFrames, ANIMATION_ACTIONS> actions;
+    SDL_Rect death;
+};
+
+const std::vector<SheetLayout> SHEET_LAYOUTS = {
+    //babyz.png, 5 x 8 frames of 75 x 125 and a death row
+    {TEXTURES::BABY_ZOMBIE, 75, 125, {{{{0}, 0}, {{1, 0, 2, 0}, 150}, {{0, 4}, 250}, {{0}, 0}}}, {0, 1000, 125, 150}},
+    //digger.png, 5 x 8 frames of 75 x 125
+    {TEXTURES::DIGGER_ZOMBIE, 75, 125, {{{{0}, 0}, {{1, 0, 2, 0}, 150}, {{0, 4}, 250}, {{0}, 0}}}, {0, 0, 0, 0}},
+    //zombieboss.png, 5 x 8 frames of 150 x 200 and a death frame at the end of the last row
+    {TEXTURES::BOSS_ZOMBIE, 150, 200, {{{{0}, 0}, {{1, 0, 2, 0}, 200}, {{0, 4}, 300}, {{0}, 0}}}, {750, 1400, 200, 200}},
+    //mohawk.png, 4 x 8 frames of 75 x 125 and a death frame at the end of the last row
+    {TEXTURES::MARINE, 75, 125, {{{{0}, 0}, {{1, 0, 2, 0}, 150}, {{0}, 0}, {{0}, 0}}}, {300, 875, 125, 125}},
+};
+
+/*
+ * Frame tables of every character sheet, flattened once from SHEET_LAYOUTS when the
+ * program starts.
+ * An animation id packs sheet, action and direction, so an entity only keeps that one
+ * 16 bit index. Every animation is driven by the same clock, advanced once per tick.
+ * Picking an entity's clip when its draw is queued is an array lookup and a division.
+ */
+class Animations {
+public:
+    // id of the animation of sheet doing action while facing row
+    static uint16_t select(const AnimationSheet sheet, const AnimationAction action, const SheetRow row) {
+        return (static_cast<int>(sheet) * ANIMATION_ACTIONS + static_cast<int>(action)) * ANIMATION_DIRECTIONS
+            + static_cast<int>(row);
+    }
+
+    // same sheet as animation, another action or direction
+    static uint16_t select(const uint16_t animation, const AnimationAction action, const SheetRow row) {
+        return select(static_cast<AnimationSheet>(animation / (ANIMATION_ACTIONS * ANIMATION_DIRECTIONS)), action, row);
+    }
+
+    // clip of the animation at the current clock, phase staggers entities playing the same one
+    static const SDL_Rect& clip(const uint16_t animation, const int32_t phase) {
+        const Animation& a = animations[animation];
+        const uint32_t step = a.msPerFrame > 0 ? (clock + static_cast<uint32_t>(phase - phaseOrigin) * ANIMATION_PHASE_MS)
+            / a.msPerFrame : 0;
+        return frames[a.first + step % a.count];
+    }
+
+    /*
+     * Where to draw clip for an entity whose sprite fills dest. Frames bigger than the sheet's
+     * cell, the death frames, are drawn at the scale of the others and stand on the same feet
+     * rather than being squashed into dest.
+     */
+    static SDL_Rect place(const uint16_t animation, const SDL_Rect& dest, const SDL_Rect& clip) {
+        const Animation& a = animations[animation];
+        if (clip.w == a.cellW && clip.h == a.cellH) {
+            return dest;
+        }
+        const int w = clip.w * dest.w / a.cellW;
+        const int h = clip.h * dest.h / a.cellH;
+        return {dest.x + (dest.w - w) / 2, dest.y + dest.h - h, w, h};
+    }
+
+    // texture the animation's sheet is in
+    static TEXTURES texture(const uint16_t animation) {return animations[animation].texture;}
+
+    static void advance(const float delta) {clock += static_cast<uint32_t>(delta * 1000);} // delta in seconds
+    static uint32_t getClock() {return clock;}
+    static void setClock(const uint32_t ms) {clock = ms;} // replays an exact moment, for scripted frames
+    // phase that starts at clock 0, scripted frames set their first entity's id so every entity
+    // is staggered the same whatever was created before them
+    static void setPhaseOrigin(const int32_t phase) {phaseOrigin = phase;}
+
+private:
+    // frames first to first + count - 1 of the frame table
+    struct Animation {
+        TEXTURES texture;
+        uint16_t first;
+        uint16_t count;
+        uint16_t msPerFrame;
+        uint16_t cellW; // of the sheet, the size dest rects are made for
+        uint16_t cellH;
+    };
+
+    static std::vector<Animation> animations; // indexed by animation id
+    static std::vector<SDL_Rect> frames;
+    static uint32_t clock; // ms of animation time since the start
+    static int32_t phaseOrigin;
+
+    static bool build(); // fills animations and frames from SHEET_LAYOUTS
+    static const bool built;
+};
+
+#endif
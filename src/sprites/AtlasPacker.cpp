@@ -0,0 +1,52 @@
+#include <algorithm>
+#include <numeric>
+
+#include "AtlasPacker.h"
+
+AtlasPacker::AtlasPacker(const int size, const int pad) : pageSize(size), padding(pad) {
+
+}
+
+std::vector<AtlasPlacement> AtlasPacker::pack(const std::vector<SDL_Point>& sizes) {
+    std::vector<AtlasPlacement> placements(sizes.size(), {-1, {0, 0, 0, 0}});
+    pages = 0;
+    pageHeights.clear();
+
+    // tallest first keeps the shelves tight, ties keep the load order so packing is deterministic
+    std::vector<size_t> order(sizes.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](const size_t a, const size_t b) {
+        return sizes[a].y > sizes[b].y;
+    });
+
+    int shelfX = 0;
+    int shelfY = 0;
+    int shelfH = 0;
+
+    for (const size_t i : order) {
+        const int w = sizes[i].x + padding * 2;
+        const int h = sizes[i].y + padding * 2;
+        if (w > pageSize || h > pageSize) {
+            continue;
+        }
+
+        if (pages == 0 || shelfX + w > pageSize) {
+            // next shelf, or next page when it would run off the bottom
+            shelfY += shelfH;
+            shelfX = 0;
+            shelfH = 0;
+            if (pages == 0 || shelfY + h > pageSize) {
+                ++pages;
+                pageHeights.push_back(0);
+                shelfY = 0;
+            }
+        }
+
+        placements[i] = {pages - 1, {shelfX + padding, shelfY + padding, sizes[i].x, sizes[i].y}};
+        shelfX += w;
+        shelfH = std::max(shelfH, h);
+        pageHeights.back() = std::max(pageHeights.back(), shelfY + shelfH);
+    }
+
+    return placements;
+}
@@ -0,0 +1,37 @@
+#ifndef ATLASPACKER_H
+#define ATLASPACKER_H
+
+#include <SDL2/SDL.h>
+#include <vector>
+
+// where a packed image ended up, page is -1 when it cannot fit on a page at all
+struct AtlasPlacement {
+    int page;
+    SDL_Rect rect;
+};
+
+/*
+ * Packs image sizes onto square atlas pages with a next fit decreasing height shelf packer.
+ * Images are placed tallest first along horizontal shelves, a new shelf is opened when the
+ * current one is full and a new page when the shelves reach the bottom.
+ * Every image keeps padding empty pixels around it so filtering never samples a neighbour.
+ */
+class AtlasPacker {
+public:
+    AtlasPacker(const int pageSize, const int padding);
+    ~AtlasPacker() = default;
+
+    // placements in the same order as sizes, w and h of each point are the image size
+    std::vector<AtlasPlacement> pack(const std::vector<SDL_Point>& sizes);
+
+    int getPages() const {return pages;} // pages used by the last pack
+    int getPageHeight(const int page) const {return pageHeights[page];} // rows of the page actually used
+
+private:
+    int pageSize;
+    int padding;
+    int pages = 0;
+    std::vector<int> pageHeights;
+};
+
+#endif
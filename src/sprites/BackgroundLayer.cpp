@@ -0,0 +1,107 @@
+#include <algorithm>
+
+#include "BackgroundLayer.h"
+#include "../log/log.h"
+
+BackgroundLayer::~BackgroundLayer() {
+    release();
+}
+
+void BackgroundLayer::release() {
+    for (SDL_Texture *chunk : chunks) {
+        SDL_DestroyTexture(chunk);
+    }
+    chunks.clear();
+    columns = 0;
+    rows = 0;
+}
+
+/**
+ * Draws every chunk into its own render target: the BARREN tiles covering it, then the
+ * walls overlapping it as CONCRETE, the same sprites the match drew for them every frame.
+ * On failure nothing is left baked, covers() is false everywhere and the version stays -1,
+ * so the caller keeps drawing the ground and the walls itself.
+ */
+bool BackgroundLayer::bake(SDL_Renderer *renderer, const SDL_Rect& bakeArea, const std::vector<SDL_Rect>& walls,
+        const int mapVersion) {
+    release();
+    version = -1;
+    area = bakeArea;
+
+    if (!SDL_RenderTargetSupported(renderer)) {
+        logv("Render targets unsupported, background drawn per tile\n");
+        return false;
+    }
+
+    columns = (area.w + BACKGROUND_CHUNK_SIZE - 1) / BACKGROUND_CHUNK_SIZE;
+    rows = (area.h + BACKGROUND_CHUNK_SIZE - 1) / BACKGROUND_CHUNK_SIZE;
+
+    const SpriteRegion *ground = Renderer::getRegion(static_cast<int>(TEXTURES::BARREN));
+    const SpriteRegion *wall = Renderer::getRegion(static_cast<int>(TEXTURES::CONCRETE));
+    SDL_Texture *target = SDL_GetRenderTarget(renderer);
+
+    for (int row = 0; row < rows; ++row) {
+        for (int column = 0; column < columns; ++column) {
+            SDL_Texture *chunk = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_TARGET,
+                BACKGROUND_CHUNK_SIZE, BACKGROUND_CHUNK_SIZE);
+            if (chunk == nullptr || SDL_SetRenderTarget(renderer, chunk) != 0) {
+                logv("Unable to bake background chunk: %s\n", SDL_GetError());
+                SDL_DestroyTexture(chunk);
+                SDL_SetRenderTarget(renderer, target);
+                release();
+                return false;
+            }
+            chunks.push_back(chunk);
+
+            const SDL_Rect bounds = {area.x + column * BACKGROUND_CHUNK_SIZE, area.y + row * BACKGROUND_CHUNK_SIZE,
+                BACKGROUND_CHUNK_SIZE, BACKGROUND_CHUNK_SIZE};
+            SDL_RenderClear(renderer);
+
+            for (int y = 0; ground != nullptr && y < BACKGROUND_CHUNK_SIZE; y += TEXTURE_SIZE) {
+                for (int x = 0; x < BACKGROUND_CHUNK_SIZE; x += TEXTURE_SIZE) {
+                    const SDL_Rect dest = {x, y, TEXTURE_SIZE, TEXTURE_SIZE};
+                    SDL_RenderCopy(renderer, ground->texture, &ground->rect, &dest);
+                }
+            }
+
+            for (const auto& w : walls) {
+                if (wall != nullptr && SDL_HasIntersection(&w, &bounds)) {
+                    const SDL_Rect dest = {w.x - bounds.x, w.y - bounds.y, w.w, w.h};
+                    SDL_RenderCopy(renderer, wall->texture, &wall->rect, &dest);
+                }
+            }
+        }
+    }
+
+    SDL_SetRenderTarget(renderer, target);
+    version = mapVersion;
+    logv("Baked background into %d chunks\n", columns * rows);
+    return true;
+}
+
+void BackgroundLayer::render(SDL_Renderer *renderer, const SDL_Rect& cam) const {
+    const SDL_Rect baked = {area.x, area.y, columns * BACKGROUND_CHUNK_SIZE, rows * BACKGROUND_CHUNK_SIZE};
+    if (chunks.empty() || !SDL_HasIntersection(&cam, &baked)) {
+        return;
+    }
+
+    // range of chunks overlapping the camera, clamped to the baked area
+    const int firstColumn = std::max(0, (cam.x - area.x) / BACKGROUND_CHUNK_SIZE);
+    const int firstRow = std::max(0, (cam.y - area.y) / BACKGROUND_CHUNK_SIZE);
+    const int lastColumn = std::min(columns - 1, (cam.x + cam.w - 1 - area.x) / BACKGROUND_CHUNK_SIZE);
+    const int lastRow = std::min(rows - 1, (cam.y + cam.h - 1 - area.y) / BACKGROUND_CHUNK_SIZE);
+
+    for (int row = firstRow; row <= lastRow; ++row) {
+        for (int column = firstColumn; column <= lastColumn; ++column) {
+            const SDL_Rect dest = {area.x + column * BACKGROUND_CHUNK_SIZE - cam.x,
+                area.y + row * BACKGROUND_CHUNK_SIZE - cam.y, BACKGROUND_CHUNK_SIZE, BACKGROUND_CHUNK_SIZE};
+            SDL_RenderCopy(renderer, chunks[row * columns + column], nullptr, &dest);
+        }
+    }
+}
+
+bool BackgroundLayer::covers(const SDL_Rect& rect) const {
+    return !chunks.empty() && rect.x >= area.x && rect.y >= area.y
+        && rect.x + rect.w <= area.x + columns * BACKGROUND_CHUNK_SIZE
+        && rect.y + rect.h <= area.y + rows * BACKGROUND_CHUNK_SIZE;
+}
@@ -0,0 +1,46 @@
+#ifndef BACKGROUNDLAYER_H
+#define BACKGROUNDLAYER_H
+
+#include <SDL2/SDL.h>
+#include <vector>
+
+#include "Renderer.h"
+
+// side of a baked chunk texture, a whole number of ground tiles so tiles never straddle two chunks
+static constexpr int BACKGROUND_CHUNK_SIZE = TEXTURE_SIZE * 4;
+
+/*
+ * The static part of the map, the ground tiles and the walls, drawn once into
+ * BACKGROUND_CHUNK_SIZE render target textures instead of being blitted tile by tile every frame.
+ * A frame then costs one copy per chunk in view, a handful at any window size.
+ * The chunks must be baked again whenever the walls change or the renderer
+ * drops its render targets (SDL_RENDER_TARGETS_RESET).
+ */
+class BackgroundLayer {
+public:
+    BackgroundLayer() = default;
+    ~BackgroundLayer();
+
+    BackgroundLayer(const BackgroundLayer&) = delete;
+    BackgroundLayer& operator=(const BackgroundLayer&) = delete;
+
+    // bakes the ground over area, which must be tile aligned, with the walls on top, returns success
+    bool bake(SDL_Renderer *renderer, const SDL_Rect& area, const std::vector<SDL_Rect>& walls, const int version);
+    void invalidate() {version = -1;} // forces the next bake
+
+    void render(SDL_Renderer *renderer, const SDL_Rect& cam) const; // copies the chunks in view
+    bool covers(const SDL_Rect& rect) const; // true when rect, in map coordinates, is entirely baked
+
+    int getVersion() const {return version;} // map version the chunks were baked from, -1 when not baked
+
+private:
+    void release();
+
+    std::vector<SDL_Texture *> chunks; // row major
+    SDL_Rect area = {0, 0, 0, 0};
+    int columns = 0;
+    int rows = 0;
+    int version = -1;
+};
+
+#endif
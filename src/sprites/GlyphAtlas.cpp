@@ -0,0 +1,185 @@
+#include <algorithm>
+#include <cstring>
+
+#include "GlyphAtlas.h"
+#include "AtlasPacker.h"
+#include "Renderer.h"
+#include "../log/log.h"
+
+GlyphAtlas::~GlyphAtlas() {
+    release();
+}
+
+void GlyphAtlas::release() {
+    if (texture != nullptr) {
+        SDL_DestroyTexture(texture);
+        texture = nullptr;
+    }
+    layouts.clear();
+    pending.clear();
+    glyphs = {};
+}
+
+/**
+ * Renders every printable character white on its own surface, packs them with the sprite
+ * atlas packer onto one page and uploads it. draw() tints the white glyphs with the colour
+ * it is given, so one atlas serves every colour of the font.
+ */
+bool GlyphAtlas::load(SDL_Renderer *renderer, TTF_Font *font) {
+    release();
+    if (font == nullptr) {
+        return false;
+    }
+    lineHeight = TTF_FontHeight(font);
+
+    std::array<SDL_Surface *, GLYPH_COUNT> surfaces{};
+    std::vector<SDL_Point> sizes(GLYPH_COUNT, {0, 0});
+
+    for (int i = 0; i < GLYPH_COUNT; ++i) {
+        const Uint16 ch = FIRST_GLYPH + i;
+        int minx, maxx, miny, maxy;
+        if (TTF_GlyphMetrics(font, ch, &minx, &maxx, &miny, &maxy, &glyphs[i].advance) == -1) {
+            glyphs[i].advance = 0;
+            continue;
+        }
+        if ((surfaces[i] = TTF_RenderGlyph_Blended(font, ch, SDL_Color{0xFF, 0xFF, 0xFF, 0xFF})) != nullptr) {
+            sizes[i] = {surfaces[i]->w, surfaces[i]->h};
+        }
+    }
+
+    AtlasPacker packer(ATLAS_PAGE_SIZE, ATLAS_PADDING);
+    const std::vector<AtlasPlacement> placements = packer.pack(sizes);
+
+    SDL_Surface *page = nullptr;
+    if (packer.getPages() != 1) {
+        logv("Glyphs do not fit on one %dpx page\n", ATLAS_PAGE_SIZE);
+    } else if ((page = SDL_CreateRGBSurfaceWithFormat(0, ATLAS_PAGE_SIZE, packer.getPageHeight(0), 32,
+            SDL_PIXELFORMAT_ARGB8888)) == nullptr) {
+        logv("Cannot create glyph page, error: %s\n", SDL_GetError());
+    } else {
+        SDL_FillRect(page, nullptr, 0);
+    }
+
+    for (int i = 0; i < GLYPH_COUNT; ++i) {
+        if (surfaces[i] == nullptr) {
+            continue;
+        }
+        if (page != nullptr && placements[i].page == 0) {
+            SDL_Rect dest = placements[i].rect;
+            SDL_SetSurfaceBlendMode(surfaces[i], SDL_BLENDMODE_NONE);
+            SDL_BlitSurface(surfaces[i], nullptr, page, &dest);
+            glyphs[i].rect = placements[i].rect;
+        }
+        SDL_FreeSurface(surfaces[i]);
+    }
+
+    if (page == nullptr) {
+        return false;
+    }
+
+    textureW = page->w;
+    textureH = page->h;
+    texture = SDL_CreateTextureFromSurface(renderer, page);
+    SDL_FreeSurface(page);
+    if (texture == nullptr) {
+        logv("Cannot create glyph texture, error: %s\n", SDL_GetError());
+        return false;
+    }
+    SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+    return true;
+}
+
+/**
+ * Looks the text up by its FNV-1a hash, laying it out only the first time it is seen.
+ * The cache is emptied when it grows past MAX_TEXT_LAYOUTS so text built from counters
+ * cannot grow it forever.
+ */
+const TextLayout& GlyphAtlas::layout(const char *text) {
+    uint64_t hash = 14695981039346656037ULL;
+    for (const char *c = text; *c != '\0'; ++c) {
+        hash = (hash ^ static_cast<unsigned char>(*c)) * 1099511628211ULL;
+    }
+
+    auto it = layouts.find(hash);
+    if (it != layouts.end() && strcmp(it->second.text.c_str(), text) == 0) {
+        return it->second;
+    }
+
+    if (it == layouts.end() && layouts.size() >= MAX_TEXT_LAYOUTS) {
+        layouts.clear();
+    }
+
+    TextLayout& result = layouts[hash];
+    result.text = text;
+    result.w = 0;
+    result.h = lineHeight;
+    result.quads.clear();
+
+    for (const char *c = text; *c != '\0'; ++c) {
+        const int i = static_cast<unsigned char>(*c) - FIRST_GLYPH;
+        if (i < 0 || i >= GLYPH_COUNT) {
+            continue;
+        }
+        if (glyphs[i].rect.w > 0) {
+            result.quads.push_back({glyphs[i].rect, result.w});
+            result.h = std::max(result.h, glyphs[i].rect.h);
+        }
+        result.w += glyphs[i].advance;
+    }
+    return result;
+}
+
+void GlyphAtlas::draw(const char *text, const int x, const int y, const SDL_Color colour) {
+    for (const auto& quad : layout(text).quads) {
+        pending.push_back({quad.rect, {x + quad.x, y, quad.rect.w, quad.rect.h}, colour});
+    }
+}
+
+/**
+ * Submits the queued glyphs in one call when SDL has RenderGeometry, otherwise one copy per
+ * glyph with the texture tinted whenever the colour changes.
+ */
+void GlyphAtlas::flush(SDL_Renderer *renderer) {
+    if (texture == nullptr || pending.empty()) {
+        pending.clear();
+        return;
+    }
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+    vertices.clear();
+    indices.clear();
+    for (const auto& g : pending) {
+        const float u0 = static_cast<float>(g.src.x) / textureW;
+        const float v0 = static_cast<float>(g.src.y) / textureH;
+        const float u1 = static_cast<float>(g.src.x + g.src.w) / textureW;
+        const float v1 = static_cast<float>(g.src.y + g.src.h) / textureH;
+        const float x0 = g.dest.x;
+        const float y0 = g.dest.y;
+        const float x1 = g.dest.x + g.dest.w;
+        const float y1 = g.dest.y + g.dest.h;
+
+        const int first = vertices.size();
+        vertices.push_back({{x0, y0}, g.colour, {u0, v0}});
+        vertices.push_back({{x1, y0}, g.colour, {u1, v0}});
+        vertices.push_back({{x1, y1}, g.colour, {u1, v1}});
+        vertices.push_back({{x0, y1}, g.colour, {u0, v1}});
+        for (const int i : {0, 1, 2, 0, 2, 3}) {
+            indices.push_back(first + i);
+        }
+    }
+    SDL_RenderGeometry(renderer, texture, vertices.data(), vertices.size(), indices.data(), indices.size());
+#else
+    SDL_Color tint = {0xFF, 0xFF, 0xFF, 0xFF};
+    SDL_SetTextureColorMod(texture, tint.r, tint.g, tint.b);
+    SDL_SetTextureAlphaMod(texture, tint.a);
+    for (const auto& g : pending) {
+        if (g.colour.r != tint.r || g.colour.g != tint.g || g.colour.b != tint.b || g.colour.a != tint.a) {
+            tint = g.colour;
+            SDL_SetTextureColorMod(texture, tint.r, tint.g, tint.b);
+            SDL_SetTextureAlphaMod(texture, tint.a);
+        }
+        SDL_RenderCopy(renderer, texture, &g.src, &g.dest);
+    }
+#endif
+    pending.clear();
+}
@@ -0,0 +1,84 @@
+#ifndef GLYPHATLAS_H
+#define GLYPHATLAS_H
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+#include <array>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+static constexpr int FIRST_GLYPH = 32; // space, the first printable ASCII character
+static constexpr int LAST_GLYPH = 126; // tilde, the last one
+static constexpr int GLYPH_COUNT = LAST_GLYPH - FIRST_GLYPH + 1;
+static constexpr size_t MAX_TEXT_LAYOUTS = 512; // layouts kept before the cache is emptied
+
+// where a glyph lives on the atlas and how far it moves the pen
+struct Glyph {
+    SDL_Rect rect;
+    int advance;
+};
+
+// a glyph of a laid out string, x is its offset from the start of the string
+struct GlyphQuad {
+    SDL_Rect rect;
+    int x;
+};
+
+// a laid out string, the text is kept to tell apart strings with the same hash
+struct TextLayout {
+    std::string text;
+    int w;
+    int h;
+    std::vector<GlyphQuad> quads;
+};
+
+/*
+ * Printable ASCII of one font at one size, rasterised once into a single texture.
+ * Strings are laid out once, cached by their hash, then drawn as a quad per glyph. Every
+ * string drawn before flush is submitted in one SDL_RenderGeometry call, each quad tinted
+ * by its own colour, so text that changes every frame costs no texture uploads and, once
+ * its strings were seen, no allocations.
+ * Glyphs are placed by their advance, kerning is not applied.
+ */
+class GlyphAtlas {
+public:
+    GlyphAtlas() = default;
+    ~GlyphAtlas();
+
+    bool load(SDL_Renderer *renderer, TTF_Font *font); // rasterises the glyphs, false if nothing can be drawn
+    void release();
+
+    const TextLayout& layout(const char *text); // cached layout of the text, characters without a glyph are skipped
+    SDL_Point measure(const char *text) {const TextLayout& l = layout(text); return {l.w, l.h};}
+
+    void draw(const char *text, const int x, const int y, const SDL_Color colour); // queues text, top left at x, y
+    void flush(SDL_Renderer *renderer); // draws and empties the queued text
+
+    int getLineHeight() const {return lineHeight;}
+    size_t getCachedLayouts() const {return layouts.size();}
+
+private:
+    // a queued glyph
+    struct GlyphDraw {
+        SDL_Rect src;
+        SDL_Rect dest;
+        SDL_Color colour;
+    };
+
+    SDL_Texture *texture = nullptr;
+    int textureW = 0;
+    int textureH = 0;
+    int lineHeight = 0;
+    std::array<Glyph, GLYPH_COUNT> glyphs{};
+    std::unordered_map<uint64_t, TextLayout> layouts;
+
+    std::vector<GlyphDraw> pending;
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+    std::vector<SDL_Vertex> vertices;
+    std::vector<int> indices;
+#endif
+};
+
+#endif
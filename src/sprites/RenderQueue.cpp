@@ -0,0 +1,143 @@
+#include <array>
+#include <cmath>
+
+#include "RenderQueue.h"
+#include "Renderer.h"
+
+void RenderQueue::push(const RenderLayer layer, const TEXTURES texture, const SDL_Rect& dest, const double angle) {
+    commands.push_back({layer, texture, dest, {0, 0, 0, 0}, static_cast<float>(angle)});
+}
+
+void RenderQueue::push(const RenderLayer layer, const TEXTURES texture, const SDL_Rect& dest, const SDL_Rect& clip,
+        const double angle) {
+    commands.push_back({layer, texture, dest, clip, static_cast<float>(angle)});
+}
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+/**
+ * Adds the two triangles of a sprite to the current batch, src is the part of the texture it shows.
+ * The corners are rotated around the centre of dest, the same way SDL_RenderCopyEx would.
+ */
+void RenderQueue::appendQuad(const DrawCommand& command, const SDL_Rect& src, const int textureW,
+        const int textureH) {
+    const SDL_Rect& d = command.dest;
+    const float cx = d.x + d.w / 2.0f;
+    const float cy = d.y + d.h / 2.0f;
+    const float hw = d.w / 2.0f;
+    const float hh = d.h / 2.0f;
+
+    float u0 = 0, v0 = 0, u1 = 1, v1 = 1;
+    if (textureW > 0 && textureH > 0) {
+        u0 = static_cast<float>(src.x) / textureW;
+        v0 = static_cast<float>(src.y) / textureH;
+        u1 = static_cast<float>(src.x + src.w) / textureW;
+        v1 = static_cast<float>(src.y + src.h) / textureH;
+    }
+
+    float cosA = 1;
+    float sinA = 0;
+    if (command.angle != 0) {
+        const float radians = command.angle * M_PI / 180;
+        cosA = cos(radians);
+        sinA = sin(radians);
+    }
+
+    // top left, top right, bottom right, bottom left
+    const std::array<float, 4> cornerX = {-hw, hw, hw, -hw};
+    const std::array<float, 4> cornerY = {-hh, -hh, hh, hh};
+    const std::array<float, 4> u = {u0, u1, u1, u0};
+    const std::array<float, 4> v = {v0, v0, v1, v1};
+
+    const int first = vertices.size();
+    for (int i = 0; i < 4; ++i) {
+        const SDL_FPoint position = {cx + cornerX[i] * cosA - cornerY[i] * sinA, cy + cornerX[i] * sinA + cornerY[i] * cosA};
+        vertices.push_back({position, {0xFF, 0xFF, 0xFF, 0xFF}, {u[i], v[i]}});
+    }
+
+    for (const int i : {0, 1, 2, 0, 2, 3}) {
+        indices.push_back(first + i);
+    }
+}
+#endif
+
+/**
+ * Sorts the frame's sprites by layer then texture with a counting sort, which keeps the
+ * order they were pushed in within a run, then draws each run in one call. Neighbouring
+ * ids packed on the same atlas page share the run.
+ */
+void RenderQueue::flush(SDL_Renderer *renderer) {
+    drawCalls = 0;
+
+    constexpr int textures = TOTAL_SPRITES;
+    constexpr int layers = static_cast<int>(RenderLayer::PROJECTILES) + 1;
+    std::array<size_t, layers * textures + 1> offsets{};
+
+    const auto key = [](const DrawCommand& c) {
+        return static_cast<int>(c.layer) * textures + static_cast<int>(c.texture);
+    };
+
+    for (const auto& c : commands) {
+        ++offsets[key(c) + 1];
+    }
+    for (size_t i = 1; i < offsets.size(); ++i) {
+        offsets[i] += offsets[i - 1];
+    }
+    sorted.resize(commands.size());
+    for (const auto& c : commands) {
+        sorted[offsets[key(c)]++] = c;
+    }
+    commands.clear();
+
+    // the sprite's part of its texture, clips are relative to the sprite
+    const auto source = [](const DrawCommand& c, const SpriteRegion& region) -> SDL_Rect {
+        if (c.clip.w > 0) {
+            return {region.rect.x + c.clip.x, region.rect.y + c.clip.y, c.clip.w, c.clip.h};
+        }
+        return region.rect;
+    };
+
+    size_t start = 0;
+    while (start < sorted.size()) {
+        const SpriteRegion *region = Renderer::getRegion(static_cast<int>(sorted[start].texture));
+        if (region == nullptr) {
+            ++start;
+            continue;
+        }
+        SDL_Texture *texture = region->texture;
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+        int textureW = 0;
+        int textureH = 0;
+        SDL_QueryTexture(texture, nullptr, nullptr, &textureW, &textureH);
+        vertices.clear();
+        indices.clear();
+#endif
+
+        // sprites of the same layer packed on the same page join the batch, the region is looked up once per id
+        size_t end = start;
+        while (end < sorted.size() && sorted[end].layer == sorted[start].layer) {
+            if (end > start && sorted[end].texture != sorted[end - 1].texture) {
+                const SpriteRegion *next = Renderer::getRegion(static_cast<int>(sorted[end].texture));
+                if (next == nullptr || next->texture != texture) {
+                    break;
+                }
+                region = next;
+            }
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+            appendQuad(sorted[end], source(sorted[end], *region), textureW, textureH);
+#else
+            const DrawCommand& c = sorted[end];
+            const SDL_Rect src = source(c, *region);
+            SDL_RenderCopyEx(renderer, texture, &src, &c.dest, c.angle, nullptr, SDL_FLIP_NONE);
+            ++drawCalls;
+#endif
+            ++end;
+        }
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+        SDL_RenderGeometry(renderer, texture, vertices.data(), vertices.size(), indices.data(), indices.size());
+        ++drawCalls;
+#endif
+        start = end;
+    }
+}
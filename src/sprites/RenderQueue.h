@@ -0,0 +1,74 @@
+#ifndef RENDERQUEUE_H
+#define RENDERQUEUE_H
+
+#include <SDL2/SDL.h>
+#include <vector>
+
+#include "SpriteTypes.h"
+
+/*
+ * Draw order of the queued sprites, lower layers are drawn first.
+ */
+enum class RenderLayer : int {
+    BACKGROUND,
+    OBJECTS, // buildings, walls, barricades, drops
+    CREEPS,
+    TURRETS,
+    MARINES,
+    PROJECTILES
+};
+
+// a sprite queued for this frame, clip.w == 0 draws the whole texture
+struct DrawCommand {
+    RenderLayer layer;
+    TEXTURES texture;
+    SDL_Rect dest;
+    SDL_Rect clip;
+    float angle; // clockwise degrees around the centre of dest, like SDL_RenderCopyEx
+};
+
+// sprites of a frame that were queued, those rejected as off screen and the zombies in view drawn with
+// less detail, either as a static impostor or merged into a neighbour's
+struct RenderStats {
+    int submitted;
+    int culled;
+    int degraded;
+};
+
+/*
+ * Collects every sprite drawn during a frame, then submits them sorted by layer and texture.
+ * Each run of sprites sharing a layer and a texture, an atlas page for the packed sprites,
+ * becomes a single SDL_RenderGeometry call, so draw calls follow the number of layers and
+ * pages on screen instead of the number of entities.
+ * Without SDL 2.0.18 the sprites are drawn one SDL_RenderCopyEx at a time, still in order
+ * and with one texture lookup per run.
+ */
+class RenderQueue {
+public:
+    RenderQueue() = default;
+    ~RenderQueue() = default;
+
+    void push(const RenderLayer layer, const TEXTURES texture, const SDL_Rect& dest, const double angle = 0.0);
+    void push(const RenderLayer layer, const TEXTURES texture, const SDL_Rect& dest, const SDL_Rect& clip,
+        const double angle = 0.0);
+
+    void flush(SDL_Renderer *renderer); // draws and empties the queue
+    void clear() {commands.clear();} // empties the queue without drawing it
+
+    size_t size() const {return commands.size();}
+    const std::vector<DrawCommand>& getCommands() const {return commands;} // queued since the last flush, in push order
+    int getDrawCalls() const {return drawCalls;} // draw calls made by the last flush
+
+private:
+    std::vector<DrawCommand> commands;
+    std::vector<DrawCommand> sorted; // commands sorted by layer then texture
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+    void appendQuad(const DrawCommand& command, const SDL_Rect& src, const int textureW, const int textureH);
+
+    std::vector<SDL_Vertex> vertices; // quads of the batch being built
+    std::vector<int> indices;
+#endif
+    int drawCalls = 0;
+};
+
+#endif
@@ -1,4 +1,7 @@
+#include <algorithm>
+
 #include "../sprites/Renderer.h"
+#include "../sprites/AtlasPacker.h"
 #include "../view/Window.h"
 #include "../log/log.h"
 
@@ -10,9 +13,13 @@
 Renderer Renderer::rInstance;
 SDL_Renderer * Renderer::renderer = nullptr;
 SDL_Window * Renderer::window = nullptr;
+SDL_Surface * Renderer::surface = nullptr;
+RenderBackend Renderer::backend = RenderBackend::ACCELERATED;
 
-std::map<int, SDL_Texture *> Renderer::sprites;
-int Renderer::tempIndex = 1000;
+std::array<SpriteRegion, TOTAL_SPRITES> Renderer::sprites{};
+std::vector<SDL_Texture *> Renderer::atlasPages;
+std::vector<Renderer::TempSlot> Renderer::tempSlots;
+std::vector<uint32_t> Renderer::freeSlots;
 
 /* DEVELOPER: Michael Goll
 ** DESIGNER:  Michael Goll
@@ -29,8 +36,16 @@ Renderer * Renderer::instance() {
 */
 Renderer::~Renderer() {
     for (const auto& s : sprites) {
-        if (s.second != nullptr) {
-            SDL_DestroyTexture(s.second);
+        if (s.texture != nullptr && !isAtlasPage(s.texture)) {
+            SDL_DestroyTexture(s.texture);
+        }
+    }
+    for (SDL_Texture * page : atlasPages) {
+        SDL_DestroyTexture(page);
+    }
+    for (const auto& t : tempSlots) {
+        if (t.region.texture != nullptr) {
+            SDL_DestroyTexture(t.region.texture);
         }
     }
 
@@ -45,37 +60,137 @@ Renderer::~Renderer() {
 */
 void Renderer::loadSprites() {
     logv("Loading Sprites...\n");
-    //Main game screen
-    createTexture(TEXTURES::MAIN, MAIN_SCREEN);
-    createTexture(TEXTURES::TEXTBOX, TEXTBOX_TEXTURE);
-    //createTexture(LOBBY_SCREEN);
-
-    //-------- map textures --------
-    createTexture(TEXTURES::BARREN, TEXTURE_BARREN);     //barren dirt
-    createTexture(TEXTURES::DEAD_GRASS, TEXTURE_MIDDLE); //dead grass
-    createTexture(TEXTURES::TERRAFORMED, TEXTURE_DIRT);  //terraformed
-    createTexture(TEXTURES::CONCRETE, REPLACE_ME);     //concrete, temporary texture for now
-
-    //-------- map object textures --------
-        //nature
-        //comsumables
-        //shops
-    createTexture(TEXTURES::MAP_OBJECTS, MAP_OBJECTS);
-
-    //-------- weapon textures --------
-    createTexture(TEXTURES::WEAPONS, REPLACE_ME); //temporary, will be replaced later
-
-    //-------- marine textures --------
-    createTexture(TEXTURES::MARINE, TEMP_MARINE_TEXTURE);
-
-    //-------- zombie textures --------
-    //baby
-    //createTexture(ZOMBIE_BABYZ);
-    createTexture(TEXTURES::BABY_ZOMBIE, TEMP_ZOMBIE_TEXTURE);
-    //digger
-    createTexture(TEXTURES::DIGGER_ZOMBIE, ZOMBIE_DIGGER);
-    //boss
-    createTexture(TEXTURES::BOSS_ZOMBIE, ZOMBIE_BOSS);
+    for (const auto& group : {MENU_SPRITES, MATCH_SPRITES}) {
+        std::vector<AtlasImage> images;
+        for (auto& file : spriteFiles(group)) {
+            file.second.surface = loadSurface(file.first);
+            images.push_back(file.second);
+        }
+        createAtlas(images);
+    }
+}
+
+std::vector<std::pair<std::string, AtlasImage>> Renderer::spriteFiles(const std::vector<SpriteFile>& group) {
+    std::vector<std::pair<std::string, AtlasImage>> files;
+
+    for (const auto& sprite : group) {
+        const auto found = std::find_if(files.begin(), files.end(), [&](const std::pair<std::string, AtlasImage>& f) {
+            return f.first == sprite.second;
+        });
+        if (found != files.end()) {
+            found->second.ids.push_back(sprite.first);
+        } else {
+            files.push_back({sprite.second, {{sprite.first}, nullptr}});
+        }
+    }
+    return files;
+}
+
+/*
+** loads an image into a 32 bit ARGB surface, the cyan colour key becomes transparent pixels
+** so the image keeps its transparency once blitted into an atlas page
+*/
+SDL_Surface * Renderer::loadSurface(const std::string filePath) {
+    SDL_Surface * image = IMG_Load(filePath.c_str());
+
+    if (image == nullptr) {
+        logv("Cannot create surface, error: %s\n", SDL_GetError());
+        return nullptr;
+    }
+
+    //gets rid of the white in the image
+    SDL_SetColorKey(image, SDL_TRUE, SDL_MapRGB(image->format, 0, 0xFF, 0xFF));
+
+    SDL_Surface * surface = SDL_CreateRGBSurfaceWithFormat(0, image->w, image->h, 32, SDL_PIXELFORMAT_ARGB8888);
+    if (surface == nullptr) {
+        logv("Cannot create surface, error: %s\n", SDL_GetError());
+    } else {
+        //copy the pixels as they are, keyed pixels are skipped and stay transparent
+        SDL_FillRect(surface, nullptr, 0);
+        SDL_SetSurfaceBlendMode(image, SDL_BLENDMODE_NONE);
+        SDL_BlitSurface(image, nullptr, surface, nullptr);
+    }
+    SDL_FreeSurface(image);
+    return surface;
+}
+
+/*
+** packs the static sprites into atlas pages so every sprite on a page can be drawn
+** without switching textures. Ids sharing an image share its region. Images too large
+** for a page get a texture of their own. Runs on the render thread, every call adds pages.
+*/
+void Renderer::createAtlas(const std::vector<AtlasImage>& images) {
+    std::vector<SDL_Point> sizes;
+    for (const auto& image : images) {
+        sizes.push_back(image.surface ? SDL_Point{image.surface->w, image.surface->h} : SDL_Point{0, 0});
+    }
+
+    int pageSize = ATLAS_PAGE_SIZE;
+    SDL_RendererInfo info;
+    if (SDL_GetRendererInfo(renderer, &info) == 0 && info.max_texture_width > 0 && info.max_texture_height > 0) {
+        pageSize = std::min({pageSize, info.max_texture_width, info.max_texture_height});
+    }
+
+    AtlasPacker packer(pageSize, ATLAS_PADDING);
+    const std::vector<AtlasPlacement> placements = packer.pack(sizes);
+    std::vector<SpriteRegion> regions(images.size(), {nullptr, {0, 0, 0, 0}});
+
+    for (int page = 0; page < packer.getPages(); ++page) {
+        SDL_Surface * pageSurface = SDL_CreateRGBSurfaceWithFormat(0, pageSize, packer.getPageHeight(page), 32,
+            SDL_PIXELFORMAT_ARGB8888);
+        if (pageSurface == nullptr) {
+            logv("Cannot create atlas page, error: %s\n", SDL_GetError());
+            continue;
+        }
+        SDL_FillRect(pageSurface, nullptr, 0);
+
+        for (size_t i = 0; i < images.size(); ++i) {
+            if (images[i].surface != nullptr && placements[i].page == page) {
+                SDL_Rect dest = placements[i].rect;
+                SDL_SetSurfaceBlendMode(images[i].surface, SDL_BLENDMODE_NONE);
+                SDL_BlitSurface(images[i].surface, nullptr, pageSurface, &dest);
+            }
+        }
+
+        SDL_Texture * texture = SDL_CreateTextureFromSurface(renderer, pageSurface);
+        SDL_FreeSurface(pageSurface);
+        if (texture == nullptr) {
+            logv("Cannot create texture, error: %s\n", SDL_GetError());
+            continue;
+        }
+        SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+        atlasPages.push_back(texture);
+
+        for (size_t i = 0; i < images.size(); ++i) {
+            if (images[i].surface != nullptr && placements[i].page == page) {
+                regions[i] = {texture, placements[i].rect};
+            }
+        }
+    }
+
+    for (size_t i = 0; i < images.size(); ++i) {
+        SDL_Surface * surface = images[i].surface;
+        if (surface == nullptr) {
+            continue;
+        }
+        if (placements[i].page == -1) {
+            //too big for a page, stands alone
+            SDL_Texture * texture = SDL_CreateTextureFromSurface(renderer, surface);
+            if (texture == nullptr) {
+                logv("Cannot create texture, error: %s\n", SDL_GetError());
+            } else {
+                regions[i] = {texture, {0, 0, surface->w, surface->h}};
+            }
+        }
+        SDL_FreeSurface(surface);
+
+        if (regions[i].texture != nullptr) {
+            for (const TEXTURES id : images[i].ids) {
+                sprites[static_cast<int>(id)] = regions[i];
+            }
+        }
+    }
+    logv("Packed %zu images into %d atlas pages of %d\n", images.size(), packer.getPages(), pageSize);
 }
 
 /* DEVELOPER: Michael Goll
@@ -93,53 +208,73 @@ TTF_Font * Renderer::loadFont(const std::string filePath, const int size) {
     return font;
 }
 
-/* DEVELOPER: Michael Goll
-** DESIGNER:  Michael Goll
-** DATE:      March 14, 2017
-** creates a texture and adds it to the array
-*/
-void Renderer::createTexture(const int index, const std::string filePath) {
-
-    SDL_Surface * surface = IMG_Load(filePath.c_str());
+bool Renderer::isAtlasPage(const SDL_Texture * texture) {
+    return std::find(atlasPages.begin(), atlasPages.end(), texture) != atlasPages.end();
+}
 
-    if (surface == nullptr) {
-        logv("Cannot create surface, error: %s\n", SDL_GetError());
+/*
+** stores a runtime texture, reusing the slot of a destroyed one when there is one
+** the slot's generation is bumped on destroy so handles to the old texture stay invalid
+*/
+TextureHandle Renderer::addTemp(SDL_Texture * texture, const int w, const int h) {
+    uint32_t index;
+    if (freeSlots.empty()) {
+        index = tempSlots.size();
+        tempSlots.push_back({{nullptr, {0, 0, 0, 0}}, 1});
     } else {
-        //gets rid of the white in the image
-        SDL_SetColorKey(surface, SDL_TRUE, SDL_MapRGB(surface->format, 0, 0xFF, 0xFF));
+        index = freeSlots.back();
+        freeSlots.pop_back();
+    }
 
-        //create texture
-        SDL_Texture * texture = SDL_CreateTextureFromSurface(renderer, surface);
+    tempSlots[index].region = {texture, {0, 0, w, h}};
+    return {index, tempSlots[index].generation};
+}
 
-        if (texture == nullptr) {
-            logv("Cannot create texture, error: %s\n", SDL_GetError());
-        } else {
-            //add the texture to the array
-            sprites.insert({static_cast<int>(index), texture});
-            SDL_FreeSurface(surface);
-        }
+void Renderer::destroyTexture(const TextureHandle handle) {
+    if (getRegion(handle) == nullptr) {
+        return;
     }
-}
 
-void Renderer::createTexture(const TEXTURES index, const std::string filePath) {
-    createTexture(static_cast<int>(index), filePath);
+    TempSlot& slot = tempSlots[handle.index];
+    SDL_DestroyTexture(slot.region.texture);
+    slot.region.texture = nullptr;
+    ++slot.generation;
+    freeSlots.push_back(handle.index);
 }
 
 /* DEVELOPER: Michael Goll
 ** DESIGNER:  Michael Goll
 ** DATE:      March 20, 2017
-** creates a texture, adds it to the map and returns its ID
+** creates a texture and returns its handle
 */
-int Renderer::createTempTexture(const std::string filePath) {
-    createTexture(tempIndex, filePath);
-    return tempIndex++;
+TextureHandle Renderer::createTempTexture(const std::string filePath) {
+    SDL_Surface * surface = IMG_Load(filePath.c_str());
+
+    if (surface == nullptr) {
+        logv("Cannot create surface, error: %s\n", SDL_GetError());
+        return NULL_TEXTURE;
+    }
+
+    //gets rid of the white in the image
+    SDL_SetColorKey(surface, SDL_TRUE, SDL_MapRGB(surface->format, 0, 0xFF, 0xFF));
+
+    //create texture
+    SDL_Texture * texture = SDL_CreateTextureFromSurface(renderer, surface);
+    TextureHandle handle = NULL_TEXTURE;
+
+    if (texture == nullptr) {
+        logv("Cannot create texture, error: %s\n", SDL_GetError());
+    } else {
+        handle = addTemp(texture, surface->w, surface->h);
+    }
+    SDL_FreeSurface(surface);
+    return handle;
 }
 
 /* DEVELOPER: Michael Goll
 ** DESIGNER:  Michael Goll
 ** DATE:      March 14, 2017
-** creates a texture out of text
-** returns a 0 on error, otherwise returns the id where it is stored
+** creates a texture out of text, replacing the previous text stored at index
 */
 void Renderer::createText(const TEXTURES index, TTF_Font * font, const std::string text, const SDL_Color colour) {
     SDL_Surface * textSurface = TTF_RenderText_Solid(font, text.c_str(), colour);
@@ -152,11 +287,14 @@ void Renderer::createText(const TEXTURES index, TTF_Font * font, const std::stri
 
         if (texture == nullptr) {
             logv("Cannot create texture, error: %s\n", SDL_GetError());
-            SDL_DestroyTexture(texture);
         } else {
-            sprites.insert({static_cast<int>(index), texture});
-            SDL_FreeSurface(textSurface);
+            SpriteRegion& region = sprites[static_cast<int>(index)];
+            if (region.texture != nullptr && !isAtlasPage(region.texture)) {
+                SDL_DestroyTexture(region.texture);
+            }
+            region = {texture, {0, 0, textSurface->w, textSurface->h}};
         }
+        SDL_FreeSurface(textSurface);
     }
 }
 
@@ -164,27 +302,26 @@ void Renderer::createText(const TEXTURES index, TTF_Font * font, const std::stri
 ** DESIGNER:  Michael Goll
 ** DATE:      March 20, 2017
 ** creates a texture out of text, used for temporary texts (usernames, ect)
-** returns a 0 on error, otherwise returns the id where it is stored
+** returns NULL_TEXTURE on error, otherwise the handle to free it with once it is no longer shown
 */
-int Renderer::createTempText(TTF_Font * font, const std::string text, const SDL_Color colour) {
+TextureHandle Renderer::createTempText(TTF_Font * font, const std::string text, const SDL_Color colour) {
     SDL_Surface * textSurface = TTF_RenderText_Solid(font, text.c_str(), colour);
 
     if (textSurface == nullptr) {
         logv("Cannot create text surface, error: %s\n", TTF_GetError());
-    } else {
+        return NULL_TEXTURE;
+    }
 
-        SDL_Texture * texture = SDL_CreateTextureFromSurface(renderer, textSurface);
+    SDL_Texture * texture = SDL_CreateTextureFromSurface(renderer, textSurface);
+    TextureHandle handle = NULL_TEXTURE;
 
-        if (texture == nullptr) {
-            logv("Cannot create texture, error: %s\n", SDL_GetError());
-            SDL_DestroyTexture(texture);
-        } else {
-            sprites.insert({static_cast<int>(tempIndex), texture});
-            SDL_FreeSurface(textSurface);
-            return tempIndex++;
-        }
+    if (texture == nullptr) {
+        logv("Cannot create texture, error: %s\n", SDL_GetError());
+    } else {
+        handle = addTemp(texture, textSurface->w, textSurface->h);
     }
-    return 0;
+    SDL_FreeSurface(textSurface);
+    return handle;
 }
 
 /* DEVELOPER: Michael Goll
@@ -193,11 +330,28 @@ int Renderer::createTempText(TTF_Font * font, const std::string text, const SDL_
 ** sets the game's renderer
 */
 void Renderer::setRenderer() {
-    if ((renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED)) == nullptr) {
+    const Uint32 flags = backend == RenderBackend::SOFTWARE ? SDL_RENDERER_SOFTWARE : SDL_RENDERER_ACCELERATED;
+    if ((renderer = SDL_CreateRenderer(window, -1, flags)) == nullptr) {
         logv("Renderer could not be created\n");
     }
 }
 
+/*
+** draws into surface instead of a window, so rendering can run and be measured on machines
+** without a display or GPU. Replaces any renderer made before, textures made on it are lost.
+*/
+bool Renderer::setSurface(SDL_Surface * target) {
+    if (renderer != nullptr) {
+        SDL_DestroyRenderer(renderer);
+    }
+    surface = target;
+    if ((renderer = SDL_CreateSoftwareRenderer(surface)) == nullptr) {
+        logv("Software renderer could not be created, error: %s\n", SDL_GetError());
+        return false;
+    }
+    return true;
+}
+
 /* DEVELOPER: Michael Goll
 ** DESIGNER:  Michael Goll
 ** DATE:      March 14, 2017
@@ -215,9 +369,14 @@ void Renderer::setWindow(SDL_Window * win) {
 */
 void Renderer::render(const SDL_Rect& dest, const TEXTURES spriteType, const SDL_Rect& clip,
     double angle, const SDL_Point* center, const SDL_RendererFlip flip) {
+    const SpriteRegion * region = getRegion(static_cast<int>(spriteType));
+    if (region == nullptr) {
+        return;
+    }
+    //clip is relative to the sprite, move it to where the sprite is in its texture
+    const SDL_Rect src = {region->rect.x + clip.x, region->rect.y + clip.y, clip.w, clip.h};
     //Render to screen
-    SDL_RenderCopyEx(renderer, getTexture(static_cast<int>(spriteType)), &clip, &dest, angle,
-                     center, flip);
+    SDL_RenderCopyEx(renderer, region->texture, &src, &dest, angle, center, flip);
 }
 
 /* DEVELOPER: Michael Goll
@@ -227,9 +386,19 @@ void Renderer::render(const SDL_Rect& dest, const TEXTURES spriteType, const SDL
 */
 void Renderer::render(const SDL_Rect& dest, const TEXTURES spriteType, double angle,
     const SDL_Point* center, const SDL_RendererFlip flip) {
+    const SpriteRegion * region = getRegion(static_cast<int>(spriteType));
+    if (region == nullptr) {
+        return;
+    }
     //Render to screen
-    SDL_RenderCopyEx(renderer, getTexture(static_cast<int>(spriteType)), nullptr, &dest, angle,
-                     center, flip);
+    SDL_RenderCopyEx(renderer, region->texture, &region->rect, &dest, angle, center, flip);
+}
+
+void Renderer::render(const SDL_Rect& dest, const TextureHandle handle) {
+    const SpriteRegion * region = getRegion(handle);
+    if (region != nullptr) {
+        SDL_RenderCopy(renderer, region->texture, &region->rect, &dest);
+    }
 }
 
 /* DEVELOPER: Michael Goll
@@ -237,12 +406,22 @@ void Renderer::render(const SDL_Rect& dest, const TEXTURES spriteType, double an
 ** DATE:      March 14, 2017
 ** returns the sprite or sprite sheet that the object is looking to render
 */
-SDL_Texture * Renderer::getTexture(int spriteType) {
-    auto texture = sprites.find(spriteType);
+const SpriteRegion * Renderer::getRegion(int spriteType) {
+    if (spriteType < 0 || spriteType >= TOTAL_SPRITES || sprites[spriteType].texture == nullptr) {
+        return nullptr;
+    }
+    return &sprites[spriteType];
+}
 
-    if (texture != sprites.end()) {
-        return texture->second;
+const SpriteRegion * Renderer::getRegion(const TextureHandle handle) {
+    if (handle.index >= tempSlots.size() || tempSlots[handle.index].generation != handle.generation
+            || tempSlots[handle.index].region.texture == nullptr) {
+        return nullptr;
     }
+    return &tempSlots[handle.index].region;
+}
 
-    return nullptr;
+SDL_Texture * Renderer::getTexture(int spriteType) {
+    const SpriteRegion * region = getRegion(spriteType);
+    return region != nullptr ? region->texture : nullptr;
 }
@@ -6,7 +6,8 @@
 #include <SDL2/SDL_ttf.h>
 #include <array>
 #include <string>
-#include <map>
+#include <vector>
+#include <cstdint>
 
 #include "../sprites/SpriteTypes.h"
 #include "../log/log.h"
@@ -30,7 +31,6 @@ const std::string TEXTURE_MIDDLE = MAP_TEXTURE_PATH + "middle_dirt.png"; //dead
 
 //TODO: remove these textures, temporary for now
 const std::string TEMP_MARINE_TEXTURE = "assets/texture/arrow.png";
-const std::string TEMP_ZOMBIE_TEXTURE = "assets/texture/babyz1.png";
 
 //Sprite Sheet folder path
 const std::string SPRITE_PATH = "assets/texture/SpriteSheets/";
@@ -55,6 +55,76 @@ const std::string REPLACE_ME = "assets/texture/replace_me.png"; //temporary spri
 static constexpr int TEXTURE_SIZE = 250; //size of the texture
 static constexpr int MARINE_SIZE = 100; //size of the marine
 static constexpr int TOTAL_SPRITES = 20; //number of total sprites
+static constexpr int ATLAS_PAGE_SIZE = 2048; //largest atlas page, smaller if the renderer says so
+static constexpr int ATLAS_PADDING = 1; //empty pixels around every sprite in an atlas
+
+//a sprite id and the image it is loaded from
+using SpriteFile = std::pair<TEXTURES, std::string>;
+
+//sprites the menu needs before it can be shown
+const std::vector<SpriteFile> MENU_SPRITES = {
+    //Main game screen
+    {TEXTURES::MAIN, MAIN_SCREEN},
+    {TEXTURES::TEXTBOX, TEXTBOX_TEXTURE},
+    //{TEXTURES::LOBBY, LOBBY_SCREEN},
+};
+
+//sprites only the match uses, they can finish loading while the menu is up
+const std::vector<SpriteFile> MATCH_SPRITES = {
+    //-------- map textures --------
+    {TEXTURES::BARREN, TEXTURE_BARREN},     //barren dirt
+    {TEXTURES::DEAD_GRASS, TEXTURE_MIDDLE}, //dead grass
+    {TEXTURES::TERRAFORMED, TEXTURE_DIRT},  //terraformed
+    {TEXTURES::CONCRETE, REPLACE_ME},       //concrete, temporary texture for now
+
+    //-------- map object textures --------
+        //nature
+        //comsumables
+        //shops
+    {TEXTURES::MAP_OBJECTS, MAP_OBJECTS},
+
+    //-------- weapon textures --------
+    {TEXTURES::WEAPONS, REPLACE_ME}, //temporary, will be replaced later
+
+    //-------- marine textures --------
+    {TEXTURES::MARINE, TEMP_MARINE_TEXTURE},
+
+    //-------- zombie textures --------
+    //baby
+    {TEXTURES::BABY_ZOMBIE, ZOMBIE_BABYZ},
+    //digger
+    {TEXTURES::DIGGER_ZOMBIE, ZOMBIE_DIGGER},
+    //boss
+    {TEXTURES::BOSS_ZOMBIE, ZOMBIE_BOSS},
+};
+
+static_assert(static_cast<int>(TEXTURES::BOSS_ZOMBIE) < TOTAL_SPRITES, "TOTAL_SPRITES must cover every TEXTURES id");
+
+//where a sprite lives, rect is the part of texture holding it
+struct SpriteRegion {
+    SDL_Texture * texture;
+    SDL_Rect rect;
+};
+
+//refers to a texture created at runtime (text, temporary images), it goes stale once the texture
+//is destroyed even if its slot is reused, generation 0 is never handed out
+struct TextureHandle {
+    uint32_t index;
+    uint32_t generation;
+};
+static constexpr TextureHandle NULL_TEXTURE = {0, 0};
+
+//how the renderer draws to the window, SOFTWARE rasterises on the CPU for machines without a GPU
+enum class RenderBackend {
+    ACCELERATED,
+    SOFTWARE
+};
+
+//a decoded image and every sprite id drawn from it, waiting to be packed into an atlas
+struct AtlasImage {
+    std::vector<TEXTURES> ids;
+    SDL_Surface * surface;
+};
 
 
 class Renderer {
@@ -64,27 +134,56 @@ class Renderer {
 
         ~Renderer();
 
-        //returns the sprite or sprite sheet that the object is looking to render
+        //returns the sprite or sprite sheet that the object is looking to render, nullptr if not loaded
+        static const SpriteRegion * getRegion(int spriteType);
+
+        //returns the region of a runtime texture, nullptr once it was destroyed
+        static const SpriteRegion * getRegion(const TextureHandle handle);
+
+        //returns the texture holding the sprite, an atlas page shared with other sprites for those in an atlas
         static SDL_Texture * getTexture(int spriteType);
 
         //gets the renderer
         static SDL_Renderer * getRenderer() {return renderer;};
 
-        //sets the window
+        //sets the window and creates a renderer for it with the selected backend
         static void setWindow(SDL_Window * win);
 
-        //loads all the sprites specified in Renderer.h
+        //selects the backend the next setWindow creates its renderer with
+        static void setBackend(const RenderBackend b) {backend = b;}
+
+        //renders into an offscreen surface with the software renderer instead of a window, the caller
+        //keeps ownership of the surface, false if no renderer could be created
+        static bool setSurface(SDL_Surface * surface);
+
+        //the offscreen surface given to setSurface, nullptr when drawing to a window
+        static SDL_Surface * getSurface() {return surface;}
+
+        //loads all the sprites specified in Renderer.h, blocking until they are decoded and uploaded
         static void loadSprites();
 
+        //one entry per distinct image file, with the ids that share it, surfaces are left null
+        static std::vector<std::pair<std::string, AtlasImage>> spriteFiles(const std::vector<SpriteFile>& sprites);
+
+        //loads an image as 32 bit ARGB with the colour key turned into transparency, safe off the render thread
+        static SDL_Surface * loadSurface(const std::string filePath);
+
+        //packs the images into as few atlas pages as fit and registers a region for each id, frees the surfaces
+        static void createAtlas(const std::vector<AtlasImage>& images);
+
         static TTF_Font * loadFont(const std::string fonts, const int size);
 
         //creates a texture from a font file
         void createText(const TEXTURES index, TTF_Font * font, const std::string text, const SDL_Color colour);
 
-        int createTempText(TTF_Font * font, const std::string text, const SDL_Color colour);
+        //creates a texture out of text, NULL_TEXTURE on error
+        TextureHandle createTempText(TTF_Font * font, const std::string text, const SDL_Color colour);
 
-        //creates a temporary texture
-        int createTempTexture(const std::string filePath);
+        //creates a temporary texture, NULL_TEXTURE on error
+        TextureHandle createTempTexture(const std::string filePath);
+
+        //frees a temporary texture, its slot is reused by the next one, stale handles are ignored
+        static void destroyTexture(const TextureHandle handle);
 
         //renders all of the sprites within the camera viewport
         static void render(const SDL_Rect& dest, const TEXTURES spriteType, double angle = 0.0,
@@ -94,6 +193,9 @@ class Renderer {
         static void render(const SDL_Rect& dest, const TEXTURES spriteType, const SDL_Rect& clip, double angle = 0.0,
             const SDL_Point* center = nullptr, const SDL_RendererFlip flip = SDL_FLIP_NONE);
 
+        //renders a temporary texture
+        static void render(const SDL_Rect& dest, const TextureHandle handle);
+
 
     private:
         Renderer() = default;
@@ -101,14 +203,30 @@ class Renderer {
         static Renderer rInstance;
         static SDL_Renderer * renderer;
         static SDL_Window * window;
-        static int tempIndex;
+        static SDL_Surface * surface;
+        static RenderBackend backend;
+
+        //array of all sprites in the game, indexed by TEXTURES
+        static std::array<SpriteRegion, TOTAL_SPRITES> sprites;
+
+        //a runtime texture and the generation of the handle that owns it
+        struct TempSlot {
+            SpriteRegion region;
+            uint32_t generation;
+        };
+
+        //runtime textures, freed slots are listed in freeSlots for reuse
+        static std::vector<TempSlot> tempSlots;
+        static std::vector<uint32_t> freeSlots;
+
+        //textures the static sprites were packed into
+        static std::vector<SDL_Texture *> atlasPages;
 
-        //array of all sprites in the game
-        static std::map<int, SDL_Texture *> sprites;
+        //stores a runtime texture in a free slot and returns its handle
+        static TextureHandle addTemp(SDL_Texture * texture, const int w, const int h);
 
-        //creates a texture from a file
-        static void createTexture(const TEXTURES index, const std::string filePath);
-        static void createTexture(const int index, const std::string filePath);
+        //true if the texture is one of the atlas pages, which are shared between sprites
+        static bool isAtlasPage(const SDL_Texture * texture);
 
         //sets the renderer
         static void setRenderer();
@@ -0,0 +1,171 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <getopt.h>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
+#include <SDL2/SDL_mixer.h>
+#include <sys/stat.h>
+
+#include "../archive/AssetArchive.h"
+#include "../audio/AudioManager.h"
+#include "../sprites/Renderer.h"
+#include "../log/log.h"
+
+// an asset decoded and waiting to be written
+struct PackedAsset {
+    std::string name;
+    ArchiveEntry entry;
+    std::vector<uint8_t> data;
+};
+
+// records the loose file's size and modification time, AssetArchive::isCurrent compares them at load
+static void recordSource(const std::string& path, ArchiveEntry& entry) {
+    struct stat info;
+    if (stat(path.c_str(), &info) == 0) {
+        entry.sourceSize = info.st_size;
+        entry.sourceModified = info.st_mtime;
+    }
+}
+
+// decodes every sprite image to ARGB8888 the same way the game's loose file path does
+static void packImages(std::vector<PackedAsset>& assets) {
+    for (const auto& group : {MENU_SPRITES, MATCH_SPRITES}) {
+        for (const auto& file : Renderer::spriteFiles(group)) {
+            SDL_Surface *surface = Renderer::loadSurface(file.first);
+            if (surface == nullptr) {
+                continue;
+            }
+
+            PackedAsset asset = {file.first, {}, {}};
+            asset.entry.kind = ArchiveKind::PIXELS;
+            recordSource(file.first, asset.entry);
+            asset.entry.width = surface->w;
+            asset.entry.height = surface->h;
+            asset.data.resize(surface->w * surface->h * 4);
+
+            // rows are written without the surface's pitch padding
+            SDL_LockSurface(surface);
+            for (int y = 0; y < surface->h; ++y) {
+                memcpy(&asset.data[y * surface->w * 4], static_cast<uint8_t *>(surface->pixels) + y * surface->pitch,
+                    surface->w * 4);
+            }
+            SDL_UnlockSurface(surface);
+            SDL_FreeSurface(surface);
+            assets.push_back(std::move(asset));
+        }
+    }
+}
+
+// decodes the effects into the mixer's sample format, the one the game will open
+static void packEffects(std::vector<PackedAsset>& assets) {
+    int frequency;
+    Uint16 format;
+    int channels;
+    Mix_QuerySpec(&frequency, &format, &channels);
+
+    for (const char *fileName : EFFECT_FILES) {
+        Mix_Chunk *chunk = Mix_LoadWAV(fileName);
+        if (chunk == nullptr) {
+            printf("Skipping %s: %s\n", fileName, Mix_GetError());
+            continue;
+        }
+
+        PackedAsset asset = {fileName, {}, {chunk->abuf, chunk->abuf + chunk->alen}};
+        asset.entry.kind = ArchiveKind::PCM;
+        recordSource(fileName, asset.entry);
+        asset.entry.frequency = frequency;
+        asset.entry.format = format;
+        asset.entry.channels = channels;
+        Mix_FreeChunk(chunk);
+        assets.push_back(std::move(asset));
+    }
+}
+
+// lays out the header, index, names and aligned blobs, returns success
+static bool writeArchive(const std::string& path, std::vector<PackedAsset>& assets) {
+    ArchiveHeader header;
+    memcpy(header.magic, ARCHIVE_MAGIC, sizeof(ARCHIVE_MAGIC));
+    header.version = ARCHIVE_VERSION;
+    header.entries = assets.size();
+
+    uint64_t offset = sizeof(ArchiveHeader) + assets.size() * sizeof(ArchiveEntry);
+    for (auto& a : assets) {
+        a.entry.nameOffset = offset;
+        a.entry.nameLength = a.name.size();
+        offset += a.name.size();
+    }
+    for (auto& a : assets) {
+        offset = (offset + ARCHIVE_ALIGN - 1) / ARCHIVE_ALIGN * ARCHIVE_ALIGN;
+        a.entry.offset = offset;
+        a.entry.size = a.data.size();
+        offset += a.data.size();
+    }
+
+    FILE *out = fopen(path.c_str(), "wb");
+    if (out == nullptr) {
+        perror("fopen");
+        return false;
+    }
+
+    fwrite(&header, sizeof(header), 1, out);
+    for (const auto& a : assets) {
+        fwrite(&a.entry, sizeof(a.entry), 1, out);
+    }
+    for (const auto& a : assets) {
+        fwrite(a.name.data(), 1, a.name.size(), out);
+    }
+    for (const auto& a : assets) {
+        // zero fill up to the blob's aligned offset
+        static const char padding[ARCHIVE_ALIGN] = {};
+        fwrite(padding, 1, a.entry.offset - ftell(out), out);
+        fwrite(a.data.data(), 1, a.data.size(), out);
+    }
+
+    const bool success = ferror(out) == 0;
+    fclose(out);
+    printf("Packed %zu assets into %s, %lu bytes\n", assets.size(), path.c_str(), static_cast<unsigned long>(offset));
+    return success;
+}
+
+/*
+ * Entry point of the packer target, packs the sprites and sound effects into one archive.
+ * Run from the repository root after changing any asset.
+ * Usage: bin/packer [-o file]
+ *   -o  write the archive to file instead of ASSET_ARCHIVE
+ */
+int main(int argc, char *argv[]) {
+    std::string path = ASSET_ARCHIVE;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "o:")) != -1) {
+        switch (opt) {
+            case 'o':
+                path = optarg;
+                break;
+            case '?':
+                printf("-o output file\n");
+                return 1;
+        }
+    }
+
+    // decoding needs a mixer format, not a sound card
+    setenv("SDL_AUDIODRIVER", "dummy", 0);
+    if (SDL_Init(SDL_INIT_AUDIO) < 0 || !(IMG_Init(IMG_INIT_PNG) & IMG_INIT_PNG)
+            || Mix_OpenAudio(AUDIO_FREQUENCY, MIX_DEFAULT_FORMAT, AUDIO_CHANNELS, AUDIO_CHUNK_SIZE) < 0) {
+        printf("Could not initialize SDL: %s\n", SDL_GetError());
+        return 1;
+    }
+
+    std::vector<PackedAsset> assets;
+    packImages(assets);
+    packEffects(assets);
+    const bool success = writeArchive(path, assets);
+
+    Mix_CloseAudio();
+    IMG_Quit();
+    SDL_Quit();
+    return success ? 0 : 1;
+}
@@ -0,0 +1,149 @@
+#include "TargetKernel.h"
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+void TurretPack::clear() {
+    x.clear();
+    y.clear();
+    rangeSq.clear();
+}
+
+void TurretPack::push(const float px, const float py, const float range) {
+    x.push_back(px);
+    y.push_back(py);
+    rangeSq.push_back(range * range);
+}
+
+void ZombiePack::clear() {
+    x.clear();
+    y.clear();
+    id.clear();
+}
+
+void ZombiePack::push(const float px, const float py, const int32_t zid) {
+    x.push_back(px);
+    y.push_back(py);
+    id.push_back(zid);
+}
+
+/**
+ * Scans zombies [first, count) for turret t, continuing from bestDist/best.
+ * Strict comparisons keep the lowest index on ties, matching the vector lanes.
+ */
+static void scanScalar(const TurretPack& turrets, const size_t t, const ZombiePack& zombies,
+        const size_t first, float& bestDist, int32_t& best) {
+    const float tx = turrets.x[t];
+    const float ty = turrets.y[t];
+
+    for (size_t z = first, count = zombies.size(); z < count; ++z) {
+        const float dx = zombies.x[z] - tx;
+        const float dy = zombies.y[z] - ty;
+        const float dist = dx * dx + dy * dy;
+        if (dist < bestDist) {
+            bestDist = dist;
+            best = static_cast<int32_t>(z);
+        }
+    }
+}
+
+void nearestTargetsScalar(const TurretPack& turrets, const ZombiePack& zombies, std::vector<int32_t>& nearest) {
+    nearest.assign(turrets.size(), -1);
+
+    for (size_t t = 0, count = turrets.size(); t < count; ++t) {
+        float bestDist = turrets.rangeSq[t];
+        scanScalar(turrets, t, zombies, 0, bestDist, nearest[t]);
+    }
+}
+
+#if defined(__AVX__) || defined(__SSE2__)
+
+#if defined(__AVX__)
+// lanes per vector and the handful of ops the kernel needs
+static constexpr size_t LANES = 8;
+using vfloat = __m256;
+static inline vfloat vset1(const float f) {return _mm256_set1_ps(f);}
+static inline vfloat vload(const float *p) {return _mm256_loadu_ps(p);}
+static inline void vstore(float *p, const vfloat v) {_mm256_storeu_ps(p, v);}
+static inline vfloat vadd(const vfloat a, const vfloat b) {return _mm256_add_ps(a, b);}
+static inline vfloat vsub(const vfloat a, const vfloat b) {return _mm256_sub_ps(a, b);}
+static inline vfloat vmul(const vfloat a, const vfloat b) {return _mm256_mul_ps(a, b);}
+static inline vfloat vless(const vfloat a, const vfloat b) {return _mm256_cmp_ps(a, b, _CMP_LT_OQ);}
+static inline vfloat vselect(const vfloat mask, const vfloat a, const vfloat b) {return _mm256_blendv_ps(b, a, mask);}
+static inline vfloat vlaneIndex() {return _mm256_setr_ps(0, 1, 2, 3, 4, 5, 6, 7);}
+#else
+static constexpr size_t LANES = 4;
+using vfloat = __m128;
+static inline vfloat vset1(const float f) {return _mm_set1_ps(f);}
+static inline vfloat vload(const float *p) {return _mm_loadu_ps(p);}
+static inline void vstore(float *p, const vfloat v) {_mm_storeu_ps(p, v);}
+static inline vfloat vadd(const vfloat a, const vfloat b) {return _mm_add_ps(a, b);}
+static inline vfloat vsub(const vfloat a, const vfloat b) {return _mm_sub_ps(a, b);}
+static inline vfloat vmul(const vfloat a, const vfloat b) {return _mm_mul_ps(a, b);}
+static inline vfloat vless(const vfloat a, const vfloat b) {return _mm_cmplt_ps(a, b);}
+static inline vfloat vselect(const vfloat mask, const vfloat a, const vfloat b) {
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+static inline vfloat vlaneIndex() {return _mm_setr_ps(0, 1, 2, 3);}
+#endif
+
+/**
+ * Each lane keeps its own closest zombie, zombie indices are carried as floats
+ * (exact below 2^24) so no integer vector ops are needed. The lanes are reduced
+ * at the end and the remainder that does not fill a vector is finished by the scalar scan.
+ */
+void nearestTargets(const TurretPack& turrets, const ZombiePack& zombies, std::vector<int32_t>& nearest) {
+    nearest.assign(turrets.size(), -1);
+
+    const size_t count = zombies.size();
+    const size_t vectorCount = count - count % LANES;
+    const vfloat step = vset1(static_cast<float>(LANES));
+
+    for (size_t t = 0, turretCount = turrets.size(); t < turretCount; ++t) {
+        const vfloat tx = vset1(turrets.x[t]);
+        const vfloat ty = vset1(turrets.y[t]);
+        vfloat bestDist = vset1(turrets.rangeSq[t]);
+        vfloat bestIndex = vset1(-1);
+        vfloat index = vlaneIndex();
+
+        for (size_t z = 0; z < vectorCount; z += LANES) {
+            const vfloat dx = vsub(vload(&zombies.x[z]), tx);
+            const vfloat dy = vsub(vload(&zombies.y[z]), ty);
+            const vfloat dist = vadd(vmul(dx, dx), vmul(dy, dy));
+            const vfloat closer = vless(dist, bestDist);
+
+            bestDist = vselect(closer, dist, bestDist);
+            bestIndex = vselect(closer, index, bestIndex);
+            index = vadd(index, step);
+        }
+
+        float laneDist[LANES];
+        float laneIndex[LANES];
+        vstore(laneDist, bestDist);
+        vstore(laneIndex, bestIndex);
+
+        float dist = turrets.rangeSq[t];
+        int32_t best = -1;
+        for (size_t l = 0; l < LANES; ++l) {
+            const int32_t lane = static_cast<int32_t>(laneIndex[l]);
+            if (lane >= 0 && (laneDist[l] < dist || (laneDist[l] == dist && lane < best))) {
+                dist = laneDist[l];
+                best = lane;
+            }
+        }
+
+        scanScalar(turrets, t, zombies, vectorCount, dist, best);
+        nearest[t] = best;
+    }
+}
+
+#else
+
+void nearestTargets(const TurretPack& turrets, const ZombiePack& zombies, std::vector<int32_t>& nearest) {
+    nearestTargetsScalar(turrets, zombies, nearest);
+}
+
+#endif
@@ -0,0 +1,42 @@
+#ifndef TARGETKERNEL_H
+#define TARGETKERNEL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/*
+ * Packed turret data for the batched target search, one entry per turret looking for a target.
+ * Positions are centres, ranges are stored squared.
+ */
+struct TurretPack {
+    std::vector<float> x;
+    std::vector<float> y;
+    std::vector<float> rangeSq;
+
+    void clear();
+    void push(const float px, const float py, const float range);
+    size_t size() const {return x.size();}
+};
+
+/*
+ * Packed zombie centres and ids for the batched target search.
+ */
+struct ZombiePack {
+    std::vector<float> x;
+    std::vector<float> y;
+    std::vector<int32_t> id;
+
+    void clear();
+    void push(const float px, const float py, const int32_t zid);
+    size_t size() const {return x.size();}
+};
+
+// For every turret finds the index of the closest zombie strictly inside its range, or -1.
+// Uses AVX or SSE2 when the build enables them, otherwise falls back to the scalar version.
+void nearestTargets(const TurretPack& turrets, const ZombiePack& zombies, std::vector<int32_t>& nearest);
+
+// Reference version of nearestTargets, one zombie at a time.
+void nearestTargetsScalar(const TurretPack& turrets, const ZombiePack& zombies, std::vector<int32_t>& nearest);
+
+#endif
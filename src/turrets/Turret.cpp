@@ -7,9 +7,10 @@
 
 Turret::Turret(int32_t id, const SDL_Rect dest, const SDL_Rect &movementSize, const SDL_Rect &projectileSize,
         const SDL_Rect &damageSize, const SDL_Rect &pickupSize, bool activated, int health, int ammo,
-        bool placed, float range): Entity(id, dest, movementSize, projectileSize, damageSize,
+        bool placed, float range, int scanDelay): Entity(id, dest, movementSize, projectileSize, damageSize,
         pickupSize), Movable(id, dest, movementSize, projectileSize, damageSize,
-        pickupSize, MARINE_VELOCITY), activated(activated), ammo(ammo), placed(placed), range(range) {
+        pickupSize, MARINE_VELOCITY), activated(activated), health(health), ammo(ammo), placed(placed), range(range),
+        targetId(-1), scanTick(0), scanDelay(scanDelay), aimX(0), aimY(0) {
     //movementHitBox.setFriendly(true); Uncomment to allow movement through other players
     //projectileHitBox.setFriendly(true); Uncomment for no friendly fire
     //damageHitBox.setFriendly(true); Uncomment for no friendly fire
@@ -102,55 +103,121 @@ void Turret::placeTurret() {
 
 void Turret::pickUpTurret() {
     placed = false;
+    releaseTarget();
 }
 
 /**
- * Checks if there are any enemies in the turret's coverage area.
- * Jamie, March 1
- * Revised by Rob, March 5
+ * Checks if target's centre lies within the turret's range.
+ * Compares squared distances so no sqrt is needed.
  */
-bool Turret::targetScanTurret() {
-    //Get map of all zombies
-    const auto& mapZombies = GameManager::instance()->getZombies();
+bool Turret::inRange(const Entity& target) const {
+    const float deltaX = (target.getX() + ZOMBIE_WIDTH / 2) - (getX() + TURRET_WIDTH / 2);
+    const float deltaY = (target.getY() + ZOMBIE_HEIGHT / 2) - (getY() + TURRET_HEIGHT / 2);
+    return deltaX * deltaX + deltaY * deltaY < range * range;
+}
 
-    unsigned int closestZombieId = 0;
-    float closestZombieDist = std::numeric_limits<float>::max();
-
-    // Detect zombies
-    bool detect = false;
-    for (const auto& item : mapZombies) {
-        const auto& zombie = item.second;
-        const float zombieX = zombie.getX();
-        const float zombieY = zombie.getY();
-
-        const float xDelta = abs((abs(zombieX - ZOMBIE_WIDTH / 2) - abs(getX() - TURRET_WIDTH / 2)));
-        const float yDelta = abs((abs(zombieY - ZOMBIE_HEIGHT / 2) - abs(getY() - TURRET_HEIGHT / 2)));
-        const float distance = sqrt(xDelta * xDelta + yDelta * yDelta);
-
-        if (distance < getRange()) {
-            if (distance < closestZombieDist) {
-                closestZombieId = item.first;
-                closestZombieDist = distance;
-                detect = true;
-            }
-        }
+/**
+ * Re-validates the current target and keeps the turret pointed at it.
+ * The angle is only recomputed when the target moved since the last aim.
+ * Returns false, dropping the target, if it died or left range.
+ */
+bool Turret::trackTarget() {
+    if (targetId < 0) {
+        return false;
     }
 
-    if (!detect) {
+    const auto& mapZombies = GameManager::instance()->getZombies();
+    const auto target = mapZombies.find(targetId);
+
+    if (target == mapZombies.end() || target->second.getState() == ZombieState::ZOMBIE_DIE
+            || !inRange(target->second)) {
+        targetId = -1;
         return false;
     }
 
-    const auto& target = mapZombies.find(closestZombieId);
-    if (target == mapZombies.end()) {
+    if (target->second.getX() != aimX || target->second.getY() != aimY) {
+        aimAt(target->second);
+    }
+    return true;
+}
+
+/**
+ * Returns true if enough time has passed since the last acquisition scan,
+ * and if so counts this as the new scan.
+ */
+bool Turret::scanDue(const int currentTime) {
+    if (currentTime < scanTick + scanDelay) {
         return false;
     }
+    scanTick = currentTime;
+    return true;
+}
+
+// locks on to a newly acquired target
+void Turret::setTarget(const Entity& target) {
+    targetId = target.getId();
+    aimAt(target);
+}
+
+// points the turret at target
+void Turret::aimAt(const Entity& target) {
+    aimX = target.getX();
+    aimY = target.getY();
 
-    const float deltaX = getX() - target->second.getX();
-    const float deltaY = getY() - target->second.getY();
+    const float deltaX = (getX() + TURRET_WIDTH / 2) - (aimX + ZOMBIE_WIDTH / 2);
+    const float deltaY = (getY() + TURRET_HEIGHT / 2) - (aimY + ZOMBIE_HEIGHT / 2);
 
     // Set angle so turret points at zombie
     setAngle(((atan2(deltaX, deltaY) * 180.0) / M_PI) * -1);
-    //detectList[closestZombieId]->damage(this->attackDmg);
+}
+
+/**
+ * Checks if there are any enemies in the turret's coverage area.
+ * Jamie, March 1
+ * Revised by Rob, March 5
+ *
+ * The current target is kept for as long as it is alive and in range. Only when it is lost
+ * is a new one acquired, and then at most once every scanDelay ms, by querying the zombie
+ * quadtree for the square around the turret's range rather than walking every zombie.
+ * GameManager::updateTurrets does the same for all turrets at once through nearestTargets,
+ * this is the single turret version.
+ */
+bool Turret::targetScanTurret() {
+    if (trackTarget()) {
+        return true;
+    }
+
+    if (!scanDue(SDL_GetTicks())) {
+        return false;
+    }
+
+    const float centerX = getX() + TURRET_WIDTH / 2;
+    const float centerY = getY() + TURRET_HEIGHT / 2;
+    float closestZombieDist = range * range;
+    const Entity *closest = nullptr;
+
+    CollisionHandler& ch = GameManager::instance()->getCollisionHandler();
+    for (const auto zombie : ch.quadtreeZombie.retrieve(getRangeRect())) {
+        const float xDelta = (zombie->getX() + ZOMBIE_WIDTH / 2) - centerX;
+        const float yDelta = (zombie->getY() + ZOMBIE_HEIGHT / 2) - centerY;
+        const float distance = xDelta * xDelta + yDelta * yDelta;
+
+        if (distance < closestZombieDist) {
+            closestZombieDist = distance;
+            closest = zombie;
+        }
+    }
 
+    if (closest == nullptr) {
+        return false;
+    }
+
+    setTarget(*closest);
     return true;
 }
+
+// square around the turret's centre that contains its whole range
+SDL_Rect Turret::getRangeRect() const {
+    return {static_cast<int>(getX() + TURRET_WIDTH / 2 - range), static_cast<int>(getY() + TURRET_HEIGHT / 2 - range),
+        static_cast<int>(range * 2), static_cast<int>(range * 2)};
+}
@@ -16,13 +16,14 @@ constexpr static int PASS_ALPHA = 200;
 constexpr static int FAIL_ALPHA = 30;
 constexpr static int PLACED_ALPHA = 255;
 constexpr static int PLACE_DISTANCE = 200;
+constexpr static int TURRET_SCAN_DELAY = 250; // ms between target acquisition scans
 
 class Turret : public Movable {
 public:
 
     Turret(int32_t id, const SDL_Rect dest,const SDL_Rect &movementSize, const SDL_Rect &projectileSize,
         const SDL_Rect &damageSize, const SDL_Rect &pickupSize, bool activated = false, int health = 200,
-        int ammo = 100, bool placed = false, float range = 400.0f);
+        int ammo = 100, bool placed = false, float range = 400.0f, int scanDelay = TURRET_SCAN_DELAY);
 
     virtual ~Turret();
 
@@ -51,6 +52,16 @@ public:
 
     bool targetScanTurret(); // checks if there are any enemies in the turret's coverage area
 
+    bool inRange(const Entity& target) const; // true if target's centre is within range of the turret
+
+    bool trackTarget(); // keeps aiming at the current target, false if there is none or it was lost
+
+    bool scanDue(const int currentTime); // true if the turret may search for a new target now
+
+    void setTarget(const Entity& target); // locks on to a newly acquired target
+
+    SDL_Rect getRangeRect() const; // square around the turret that contains its range
+
     void move(const float playerX, const float playerY,
             const float moveX, const float moveY, CollisionHandler &ch);
 
@@ -68,12 +79,40 @@ public:
         return range;
     }
 
+    // returns the turret's health, it is removed once this reaches 0
+    int getHealth() const {
+        return health;
+    }
+
+    // id of the zombie the turret is locked on to, -1 if none
+    int32_t getTargetId() const {
+        return targetId;
+    }
+
+    // drops the current target so the next scan acquires a new one straight away
+    void releaseTarget() {
+        targetId = -1;
+        scanTick = 0;
+    }
+
+    // sets the minimum ms between target acquisition scans
+    void setScanDelay(const int delay) {
+        scanDelay = delay;
+    }
+
 private:
     bool activated; // turret activated state
     int health; // turret health pool
     int ammo; // turret ammo pool
     bool placed;
     float range; // turret's range.
+    int32_t targetId; // zombie currently targeted, kept until it dies or leaves range
+    int scanTick; // time of the last acquisition scan
+    int scanDelay; // minimum time between acquisition scans
+    float aimX; // target position the current angle was computed for
+    float aimY;
+
+    void aimAt(const Entity& target);
 };
 
 #endif